@@ -0,0 +1,67 @@
+#include "ChildProcess.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+namespace RomanoViolet
+{
+  bool RunChildProcess( const std::string &executable,
+                        const std::vector< std::string > &arguments,
+                        const std::string &outputFile,
+                        ChildProcessResult &result )
+  {
+    using Clock = std::chrono::steady_clock;
+
+    std::vector< char * > argv;
+    argv.emplace_back( const_cast< char * >( executable.c_str( ) ) );
+    for ( const std::string &argument : arguments ) {
+      argv.emplace_back( const_cast< char * >( argument.c_str( ) ) );
+    }
+    argv.emplace_back( nullptr );
+
+    int errors[2];
+    if ( pipe( errors ) != 0 ) {
+      return false;
+    }
+
+    const Clock::time_point start = Clock::now( );
+    const pid_t child = fork( );
+    if ( child < 0 ) {
+      close( errors[0] );
+      close( errors[1] );
+      return false;
+    }
+    if ( child == 0 ) {
+      const int output = open( outputFile.c_str( ), O_WRONLY | O_CREAT | O_TRUNC, 0644 );
+      if ( output < 0 ) {
+        _exit( 127 );
+      }
+      dup2( output, STDOUT_FILENO );
+      dup2( errors[1], STDERR_FILENO );
+      close( errors[0] );
+      execv( executable.c_str( ), argv.data( ) );
+      _exit( 127 );
+    }
+
+    // stderr is drained while the child runs, so that it never blocks on a full pipe.
+    close( errors[1] );
+    result._errors.clear( );
+    char buffer[4096];
+    ssize_t length;
+    while ( ( length = read( errors[0], buffer, sizeof( buffer ) ) ) > 0 ) {
+      result._errors.append( buffer, static_cast< std::size_t >( length ) );
+    }
+    close( errors[0] );
+
+    int status = 0;
+    struct rusage usage;
+    if ( wait4( child, &status, 0, &usage ) != child ) {
+      return false;
+    }
+    result._seconds = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+    result._peakResidentKilobytes = usage.ru_maxrss;
+    return WIFEXITED( status ) && ( WEXITSTATUS( status ) == EXIT_SUCCESS );
+  }  // RunChildProcess
+}  // namespace RomanoViolet
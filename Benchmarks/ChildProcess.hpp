@@ -0,0 +1,29 @@
+#ifndef _CHILDPROCESS_HPP_
+#define _CHILDPROCESS_HPP_
+
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief What a benchmark learns about a run of CPPProject.
+   */
+  struct ChildProcessResult {
+    double _seconds = 0.0;
+    // ru_maxrss, in kilobytes on Linux.
+    long _peakResidentKilobytes = 0;
+    // everything written to stderr.
+    std::string _errors;
+  };
+
+  /**
+   * @brief Runs executable with arguments as a child process, and waits for it.
+   * @param outputFile: Receives the stdout of the child, e.g., /dev/null to discard it.
+   * @return false if the child could not be run, or did not exit with EXIT_SUCCESS.
+   */
+  bool RunChildProcess( const std::string &executable,
+                        const std::vector< std::string > &arguments,
+                        const std::string &outputFile,
+                        ChildProcessResult &result );
+}  // namespace RomanoViolet
+#endif  // !_CHILDPROCESS_HPP_
@@ -0,0 +1,67 @@
+#include "CorpusGenerator.hpp"
+#include <fstream>
+namespace RomanoViolet
+{
+  namespace
+  {
+    void writeComponent( std::ofstream &out, const std::string &name, std::size_t fields )
+    {
+      out << "    class " << name << " : public TypeHighAssuranceComponent\n"
+          << "    {\n"
+          << "    public:\n"
+          << "      enum class ErrorCode : short { NO_ERROR = 0U, BAD_INPUT_DATA = 1U };\n\n";
+      for ( std::size_t field = 0; field < fields; ++field ) {
+        if ( field % 2 == 0 ) {
+          out << "      ::RomanoViolet::TypeInputInterface< ::RomanoViolet::InterfaceA > in_"
+              << field << ";\n";
+        } else {
+          out << "      ::RomanoViolet::TypeOutputInterface< ::RomanoViolet::InterfaceB > out_"
+              << field << ";\n";
+        }
+      }
+      out << "      int c;\n\n"
+          << "      void initialize( );\n"
+          << "      void doPreconditionCheck( );\n"
+          << "      void compute( );\n"
+          << "      void doPostConditionCheck( );\n\n"
+          << "    private:\n"
+          << "      ErrorCode _error;\n"
+          << "    };\n\n";
+    }  // writeComponent
+  }  // namespace
+
+  bool GenerateCorpus( const std::string &directory,
+                       const CorpusShape &shape,
+                       std::vector< std::string > &headers )
+  {
+    for ( std::size_t header = 0; header < shape._headers; ++header ) {
+      const std::string suffix = std::to_string( header );
+      const std::string path = directory + "/Component" + suffix + ".hpp";
+      std::ofstream out( path );
+      if ( !out ) {
+        return false;
+      }
+
+      out << "#ifndef COMPONENT" << suffix << "_HPP_\n"
+          << "#define COMPONENT" << suffix << "_HPP_\n\n"
+          << "#include <Library/ComponentTypes/Type_HighAssuranceComponent.hpp>\n"
+          << "#include <Library/InterfaceTypes/InterfaceA.hpp>\n"
+          << "#include <Library/InterfaceTypes/InterfaceB.hpp>\n"
+          << "#include <Library/InterfaceTypes/Type_InputInterface.hpp>\n"
+          << "#include <Library/InterfaceTypes/Type_OutputInterface.hpp>\n"
+          << "namespace NN\n{\n  namespace RomanoViolet\n  {\n";
+      for ( std::size_t component = 0; component < shape._components; ++component ) {
+        writeComponent(
+            out, "Component" + suffix + "_" + std::to_string( component ), shape._fields );
+      }
+      out << "  }  // namespace RomanoViolet\n}  // namespace NN\n\n"
+          << "#endif  // COMPONENT" << suffix << "_HPP_\n";
+
+      if ( !out ) {
+        return false;
+      }
+      headers.emplace_back( path );
+    }
+    return true;
+  }  // GenerateCorpus
+}  // namespace RomanoViolet
@@ -0,0 +1,33 @@
+#ifndef _CORPUSGENERATOR_HPP_
+#define _CORPUSGENERATOR_HPP_
+
+#include <cstddef>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Size of a synthetic corpus of component headers.
+   */
+  struct CorpusShape {
+    std::size_t _headers = 1;
+    // Component classes per header.
+    std::size_t _components = 1;
+    // TypeInputInterface / TypeOutputInterface fields per component, alternating.
+    std::size_t _fields = 4;
+  };
+
+  /**
+   * @brief Writes a corpus of _headers headers into directory, which must exist.
+   * @details Every header has the layout of TestVectors/Component.hpp: it includes the Library
+   * headers, and declares _components classes deriving from TypeHighAssuranceComponent inside
+   * NN::RomanoViolet. Each class has _fields interface fields, inputs and outputs alternating,
+   * plus one field of ambiguous direction.
+   * @param headers: Receives the paths of the written headers, in order.
+   * @return false if a header could not be written.
+   */
+  bool GenerateCorpus( const std::string &directory,
+                       const CorpusShape &shape,
+                       std::vector< std::string > &headers );
+}  // namespace RomanoViolet
+#endif  // !_CORPUSGENERATOR_HPP_
@@ -0,0 +1,160 @@
+/**
+ * @file ExtractionBenchmark.cpp
+ * @brief Measures CPPProject end to end on synthetic corpora of increasing size.
+ * @details For every corpus size, a corpus is generated (see CorpusGenerator.hpp) into a temporary
+ * directory, and CPPProject is run once over all of its headers as a child process. Reported are
+ * the wall time, headers/s, cursors/s and the peak resident set size of CPPProject. The number of
+ * visited cursors is taken from the --stats output of CPPProject, so that it reflects the
+ * traversal actually performed, e.g., with or without --full-traversal.
+ *
+ * Usage: ExtractionBenchmark [--cppproject <path>] [--components <m>] [--fields <k>] [--keep]
+ *                            [<number of headers>...] [-- <options of CPPProject>...]
+ *
+ * Without numbers of headers, corpora of 1, 10 and 100 headers are measured. Without options,
+ * CPPProject is run with --all-classes, so that every component of a header is extracted.
+ */
+
+#include "ChildProcess.hpp"
+#include "CorpusGenerator.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+  struct Measurement {
+    double _seconds = 0.0;
+    std::size_t _cursors = 0;
+    // ru_maxrss, in kilobytes on Linux.
+    long _peakResidentKilobytes = 0;
+  };
+
+  // Sums the "Visited cursors: N (header)" lines written by CPPProject --stats.
+  std::size_t countVisitedCursors( const std::string &errors )
+  {
+    static const char prefix[] = "Visited cursors: ";
+    std::size_t cursors = 0;
+    for ( std::size_t position = errors.find( prefix ); position != std::string::npos;
+          position = errors.find( prefix, position + 1 ) ) {
+      cursors += std::strtoul( errors.c_str( ) + position + sizeof( prefix ) - 1, nullptr, 10 );
+    }
+    return cursors;
+  }
+
+  // Runs executable with arguments, discarding its output. Returns false if it did not succeed.
+  bool run( const std::string &executable,
+            const std::vector< std::string > &arguments,
+            Measurement &measurement )
+  {
+    RomanoViolet::ChildProcessResult result;
+    const bool isSuccessful
+        = RomanoViolet::RunChildProcess( executable, arguments, "/dev/null", result );
+    measurement._seconds = result._seconds;
+    measurement._cursors = countVisitedCursors( result._errors );
+    measurement._peakResidentKilobytes = result._peakResidentKilobytes;
+    return isSuccessful;
+  }  // run
+
+  void removeCorpus( const std::string &directory, const std::vector< std::string > &headers )
+  {
+    for ( const std::string &header : headers ) {
+      unlink( header.c_str( ) );
+    }
+    rmdir( directory.c_str( ) );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  std::string executable = CPPPROJECT_EXECUTABLE;
+  RomanoViolet::CorpusShape shape;
+  shape._components = 4;
+  shape._fields = 8;
+  bool keep = false;
+  std::vector< std::size_t > sizes;
+  std::vector< std::string > options;
+
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( ( argument.compare( "--cppproject" ) == 0 ) && ( i + 1 < argc ) ) {
+      executable = argv[++i];
+    } else if ( ( argument.compare( "--components" ) == 0 ) && ( i + 1 < argc ) ) {
+      shape._components = std::strtoul( argv[++i], nullptr, 10 );
+    } else if ( ( argument.compare( "--fields" ) == 0 ) && ( i + 1 < argc ) ) {
+      shape._fields = std::strtoul( argv[++i], nullptr, 10 );
+    } else if ( argument.compare( "--keep" ) == 0 ) {
+      keep = true;
+    } else if ( argument.compare( "--" ) == 0 ) {
+      options.assign( argv + i + 1, argv + argc );
+      break;
+    } else if ( std::strtoul( argument.c_str( ), nullptr, 10 ) > 0 ) {
+      sizes.emplace_back( std::strtoul( argument.c_str( ), nullptr, 10 ) );
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--cppproject <path>] [--components <m>] [--fields <k>] [--keep]"
+                   " [<number of headers>...] [-- <options of CPPProject>...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if ( sizes.empty( ) ) {
+    sizes = { 1, 10, 100 };
+  }
+  if ( options.empty( ) ) {
+    options.emplace_back( "--all-classes" );
+  }
+  options.emplace_back( "--stats" );
+
+  std::cout << "CPPProject:   " << executable << "\n";
+  std::cout << "Components:   " << shape._components << " per header, " << shape._fields
+            << " interface fields each\n\n";
+  std::cout << std::setw( 8 ) << "Headers" << std::setw( 12 ) << "Cursors" << std::setw( 12 )
+            << "Seconds" << std::setw( 14 ) << "Headers/s" << std::setw( 14 ) << "Cursors/s"
+            << std::setw( 16 ) << "Peak RSS (MB)"
+            << "\n";
+
+  bool isSuccessful = true;
+  for ( const std::size_t size : sizes ) {
+    const char *temporary = std::getenv( "TMPDIR" );
+    std::string directory
+        = std::string( ( temporary != nullptr ) ? temporary : "/tmp" ) + "/ExtractionBenchmark.XXXXXX";
+    if ( mkdtemp( &directory[0] ) == nullptr ) {
+      std::cerr << "Unable to create a temporary directory.\n";
+      return EXIT_FAILURE;
+    }
+
+    shape._headers = size;
+    std::vector< std::string > headers;
+    Measurement measurement;
+    if ( !RomanoViolet::GenerateCorpus( directory, shape, headers ) ) {
+      std::cerr << "Unable to write corpus to: " << directory << "\n";
+      isSuccessful = false;
+    } else {
+      std::vector< std::string > arguments( options );
+      arguments.insert( arguments.end( ), headers.begin( ), headers.end( ) );
+      if ( !run( executable, arguments, measurement ) ) {
+        std::cerr << "CPPProject failed on the corpus in: " << directory << "\n";
+        isSuccessful = false;
+      }
+    }
+
+    std::cout << std::fixed << std::setprecision( 3 ) << std::setw( 8 ) << size << std::setw( 12 )
+              << measurement._cursors << std::setw( 12 ) << measurement._seconds
+              << std::setprecision( 1 ) << std::setw( 14 )
+              << static_cast< double >( size ) / measurement._seconds << std::setw( 14 )
+              << static_cast< double >( measurement._cursors ) / measurement._seconds
+              << std::setw( 16 ) << static_cast< double >( measurement._peakResidentKilobytes ) / 1024.0
+              << "\n";
+
+    if ( keep ) {
+      std::cout << "  corpus kept in " << directory << "\n";
+    } else {
+      removeCorpus( directory, headers );
+    }
+  }
+
+  return isSuccessful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,265 @@
+/**
+ * @file FastPathCheck.cpp
+ * @brief Checks that CPPProject --fast prints what the regular extraction prints.
+ * @details CPPProject is run as a child process per header, once with --fast and once without,
+ * each with and without --all-classes, and the outputs are compared byte by byte. The headers are
+ * TestVectors/Component.hpp, generated corpora (see CorpusGenerator.hpp), and headers which leave
+ * the layout of the fast path (see TokenScanner.hpp) with a template, a struct, a typedef, a
+ * preprocessor conditional, a forward declaration or a default member initializer, either before
+ * the first class or after it. The fast path is also expected to fall back for exactly the headers
+ * which leave the layout where it scans, i.e., anywhere with --all-classes, before the end of the
+ * first class otherwise, and anywhere for preprocessor conditionals, which --stats reports. Any
+ * other outcome fails the check.
+ *
+ * Usage: FastPathCheck [--cppproject <path>] [<header>...]
+ *
+ * Headers given are compared as well, without expecting a fall back or not.
+ */
+
+#include "ChildProcess.hpp"
+#include "CorpusGenerator.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+  // A construct the fast path does not understand, and where a header puts it.
+  struct Fallback {
+    const char *_name;
+    const char *_construct;
+    bool _isInClass;
+    // Preprocessor directives are checked over the whole header, ahead of the scan.
+    bool _isSeenAnywhere;
+  };
+
+  const Fallback fallbacks[]
+      = { { "Template",
+            "    template < typename T >\n"
+            "    class Holder\n"
+            "    {\n"
+            "    public:\n"
+            "      T _value;\n"
+            "    };\n",
+            false,
+            false },
+          { "Struct", "    struct Settings {\n      int _gain;\n    };\n", false, false },
+          { "Typedef",
+            "      typedef ::RomanoViolet::TypeOutputInterface< ::RomanoViolet::InterfaceA > "
+            "OutputA;\n"
+            "      OutputA a_out;\n",
+            true,
+            false },
+          { "Conditional",
+            "#if defined( WITH_B_IN )\n"
+            "      ::RomanoViolet::TypeInputInterface< ::RomanoViolet::InterfaceB > b_in;\n"
+            "#endif\n",
+            true,
+            true },
+          { "ForwardDeclaration", "    class Settings;\n", false, false },
+          { "DefaultMemberInitializer", "      int d = 1;\n", true, false } };
+
+  enum class Expectation : short { FAST, FALLBACK, EITHER };
+
+  struct Case {
+    std::string _header;
+    Expectation _expected;
+    Expectation _expectedWithAllClasses;
+  };
+
+  // A component class with the construct in its body if isInClass, or else ahead of the class.
+  void writeClass( std::ofstream &out, const std::string &name, const Fallback *fallback )
+  {
+    if ( ( fallback != nullptr ) && !fallback->_isInClass ) {
+      out << fallback->_construct << "\n";
+    }
+    out << "    class " << name << " : public TypeHighAssuranceComponent\n"
+        << "    {\n"
+        << "    public:\n";
+    if ( ( fallback != nullptr ) && fallback->_isInClass ) {
+      out << fallback->_construct;
+    }
+    out << "      ::RomanoViolet::TypeInputInterface< ::RomanoViolet::InterfaceA > a_in;\n"
+        << "      ::RomanoViolet::TypeOutputInterface< ::RomanoViolet::InterfaceB > b_out;\n"
+        << "      ::RomanoViolet::InterfaceB b2;\n"
+        << "      int c;\n\n"
+        << "      void compute( );\n"
+        << "    };\n\n";
+  }
+
+  // A header of two classes, the first of which holds the construct if isFirst, the second if not.
+  bool writeFallbackHeader( const std::string &path, const Fallback &fallback, bool isFirst )
+  {
+    std::ofstream out( path );
+    out << "#ifndef FALLBACK_HPP_\n"
+        << "#define FALLBACK_HPP_\n\n"
+        << "#include <Library/ComponentTypes/Type_HighAssuranceComponent.hpp>\n"
+        << "#include <Library/InterfaceTypes/InterfaceA.hpp>\n"
+        << "#include <Library/InterfaceTypes/InterfaceB.hpp>\n"
+        << "#include <Library/InterfaceTypes/Type_InputInterface.hpp>\n"
+        << "#include <Library/InterfaceTypes/Type_OutputInterface.hpp>\n"
+        << "namespace NN\n{\n  namespace RomanoViolet\n  {\n";
+    writeClass( out, std::string( fallback._name ) + "First", isFirst ? &fallback : nullptr );
+    writeClass( out, std::string( fallback._name ) + "Second", isFirst ? nullptr : &fallback );
+    out << "  }  // namespace RomanoViolet\n}  // namespace NN\n\n"
+        << "#endif  // FALLBACK_HPP_\n";
+    return static_cast< bool >( out );
+  }
+
+  std::string readFile( const std::string &path )
+  {
+    std::ifstream in( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( in ),
+                        std::istreambuf_iterator< char >( ) );
+  }
+
+  const char *describe( Expectation expectation )
+  {
+    switch ( expectation ) {
+      case Expectation::FAST:
+        return "fast";
+      case Expectation::FALLBACK:
+        return "fallback";
+      default:
+        return "either";
+    }
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  std::string executable = CPPPROJECT_EXECUTABLE;
+  std::vector< Case > cases;
+
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( ( argument.compare( "--cppproject" ) == 0 ) && ( i + 1 < argc ) ) {
+      executable = argv[++i];
+    } else if ( argument.compare( 0, 2, "--" ) != 0 ) {
+      cases.push_back( { argument, Expectation::EITHER, Expectation::EITHER } );
+    } else {
+      std::cerr << "Usage: " << argv[0] << " [--cppproject <path>] [<header>...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  const char *temporary = std::getenv( "TMPDIR" );
+  std::string directory
+      = std::string( ( temporary != nullptr ) ? temporary : "/tmp" ) + "/FastPathCheck.XXXXXX";
+  if ( mkdtemp( &directory[0] ) == nullptr ) {
+    std::cerr << "Unable to create a temporary directory.\n";
+    return EXIT_FAILURE;
+  }
+  const std::string outputFile = directory + "/output.txt";
+  std::vector< std::string > files;
+  std::vector< std::string > directories;
+
+  bool isWritten = true;
+  cases.push_back( { CPPPROJECT_SOURCE_DIR "/TestVectors/Component.hpp",
+                     Expectation::FAST,
+                     Expectation::FAST } );
+  // one class without fields, and headers of several classes.
+  const std::size_t shapes[][3] = { { 1, 1, 0 }, { 4, 3, 6 } };
+  for ( const auto &size : shapes ) {
+    RomanoViolet::CorpusShape shape;
+    shape._headers = size[0];
+    shape._components = size[1];
+    shape._fields = size[2];
+    directories.emplace_back( directory + "/corpus" + std::to_string( directories.size( ) ) );
+    std::vector< std::string > headers;
+    isWritten = isWritten && ( mkdir( directories.back( ).c_str( ), 0700 ) == 0 )
+                && RomanoViolet::GenerateCorpus( directories.back( ), shape, headers );
+    for ( const std::string &header : headers ) {
+      cases.push_back( { header, Expectation::FAST, Expectation::FAST } );
+    }
+    files.insert( files.end( ), headers.begin( ), headers.end( ) );
+  }
+  // without --all-classes, the scan ends with the first class, and a construct in the second one
+  // is not seen, unless it is a directive.
+  for ( const Fallback &fallback : fallbacks ) {
+    for ( const bool isFirst : { true, false } ) {
+      const std::string header
+          = directory + "/" + fallback._name + ( isFirst ? "First" : "Second" ) + ".hpp";
+      isWritten = isWritten && writeFallbackHeader( header, fallback, isFirst );
+      cases.push_back( { header,
+                         ( isFirst || fallback._isSeenAnywhere ) ? Expectation::FALLBACK
+                                                                 : Expectation::FAST,
+                         Expectation::FALLBACK } );
+      files.emplace_back( header );
+    }
+  }
+
+  std::cout << "CPPProject:   " << executable << "\n\n";
+  std::cout << std::left << std::setw( 40 ) << "Header" << std::setw( 15 ) << "Options"
+            << std::setw( 10 ) << "Expected" << std::setw( 10 ) << "Took"
+            << "Output\n";
+
+  std::size_t failures = isWritten ? 0 : 1;
+  if ( !isWritten ) {
+    std::cerr << "Unable to write the headers into " << directory << ".\n";
+  }
+  for ( const Case &check : cases ) {
+    for ( const bool allClasses : { false, true } ) {
+      std::vector< std::string > arguments = { "--jobs", "1" };
+      if ( allClasses ) {
+        arguments.emplace_back( "--all-classes" );
+      }
+      arguments.emplace_back( check._header );
+
+      RomanoViolet::ChildProcessResult result;
+      const bool isRegularRun
+          = RomanoViolet::RunChildProcess( executable, arguments, outputFile, result );
+      const std::string regular = readFile( outputFile );
+
+      arguments.insert( arguments.begin( ), { "--fast", "--stats" } );
+      const bool isFastRun
+          = RomanoViolet::RunChildProcess( executable, arguments, outputFile, result );
+      const std::string fast = readFile( outputFile );
+
+      const Expectation expected
+          = allClasses ? check._expectedWithAllClasses : check._expected;
+      const bool isFallenBack
+          = result._errors.find( "Fast path fell back" ) != std::string::npos;
+      std::string verdict;
+      if ( !isRegularRun || !isFastRun ) {
+        verdict = "failed";
+      } else if ( fast != regular ) {
+        verdict = "differs";
+      } else if ( regular.empty( ) ) {
+        verdict = "empty";
+      } else if ( ( expected != Expectation::EITHER )
+                  && ( isFallenBack != ( expected == Expectation::FALLBACK ) ) ) {
+        verdict = "same, but unexpected path";
+      } else {
+        verdict = "same";
+      }
+      if ( verdict.compare( "same" ) != 0 ) {
+        ++failures;
+      }
+
+      const std::size_t slash = check._header.rfind( '/' );
+      std::cout << std::left << std::setw( 40 ) << check._header.substr( slash + 1 )
+                << std::setw( 15 ) << ( allClasses ? "--all-classes" : "" ) << std::setw( 10 )
+                << describe( expected ) << std::setw( 10 ) << ( isFallenBack ? "fallback" : "fast" )
+                << verdict << "\n";
+    }
+  }
+
+  unlink( outputFile.c_str( ) );
+  for ( const std::string &file : files ) {
+    unlink( file.c_str( ) );
+  }
+  for ( const std::string &corpus : directories ) {
+    rmdir( corpus.c_str( ) );
+  }
+  rmdir( directory.c_str( ) );
+
+  std::cout << "\nFailures:     " << failures << "\n";
+  return ( failures == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
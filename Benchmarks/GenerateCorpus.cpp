@@ -0,0 +1,42 @@
+/**
+ * @file GenerateCorpus.cpp
+ * @brief Writes a synthetic corpus of component headers, e.g., for profiling CPPProject by hand.
+ *
+ * Usage: GenerateCorpus <directory> <headers> <components per header> <fields per component>
+ */
+
+#include "CorpusGenerator.hpp"
+#include <cerrno>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  if ( argc != 5 ) {
+    std::cerr << "Usage: " << argv[0]
+              << " <directory> <headers> <components per header> <fields per component>\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string directory = argv[1];
+  if ( ( mkdir( directory.c_str( ), 0755 ) != 0 ) && ( errno != EEXIST ) ) {
+    std::cerr << "Unable to create directory: " << directory << "\n";
+    return EXIT_FAILURE;
+  }
+
+  RomanoViolet::CorpusShape shape;
+  shape._headers = std::strtoul( argv[2], nullptr, 10 );
+  shape._components = std::strtoul( argv[3], nullptr, 10 );
+  shape._fields = std::strtoul( argv[4], nullptr, 10 );
+
+  std::vector< std::string > headers;
+  if ( !RomanoViolet::GenerateCorpus( directory, shape, headers ) ) {
+    std::cerr << "Unable to write corpus to: " << directory << "\n";
+    return EXIT_FAILURE;
+  }
+  std::cout << "Wrote " << headers.size( ) << " headers to " << directory << "\n";
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,148 @@
+/**
+ * @file ParseProfileBenchmark.cpp
+ * @brief Compares the parse profiles of CPPProject, with and without stub headers.
+ * @details CPPProject is run as a child process over the same headers once per configuration:
+ * --parse-profile full and lean, each without and with --stub-includes. Reported are the parse
+ * time and the peak libclang memory, both taken from the --profile json output of CPPProject, the
+ * wall time and peak resident set size of CPPProject, and whether the output is the one of the
+ * full profile without stubs. A configuration whose output differs is not fit for the headers.
+ *
+ * Usage: ParseProfileBenchmark [--cppproject <path>] [--stub-includes <directory>]
+ *                              [<header|directory>...] [-- <options of CPPProject>...]
+ *
+ * Without headers, TestVectors/Component.hpp is measured. Without a directory of stubs, the ones
+ * in CoreFunctions/Application/StubHeaders are used. Without options, CPPProject is run with
+ * --jobs 1, so that the parse time is not spread over workers.
+ */
+
+#include "ChildProcess.hpp"
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+namespace
+{
+  struct Configuration {
+    const char *_name;
+    const char *_parseProfile;
+    bool _isStubbed;
+  };
+
+  const Configuration configurations[] = { { "full", "full", false },
+                                           { "lean", "lean", false },
+                                           { "full + stubs", "full", true },
+                                           { "lean + stubs", "lean", true } };
+
+  // The number following key, e.g., "\"memory_total\":", in the JSON profile. 0 if not found.
+  double readNumber( const std::string &profile, const std::string &key, std::size_t from = 0 )
+  {
+    const std::size_t position = profile.find( key, from );
+    if ( position == std::string::npos ) {
+      return 0.0;
+    }
+    return std::strtod( profile.c_str( ) + position + key.size( ), nullptr );
+  }
+
+  std::string readFile( const std::string &path )
+  {
+    std::ifstream in( path, std::ios::binary );
+    return std::string( std::istreambuf_iterator< char >( in ), std::istreambuf_iterator< char >( ) );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  std::string executable = CPPPROJECT_EXECUTABLE;
+  std::string stubIncludes = CPPPROJECT_SOURCE_DIR "/CoreFunctions/Application/StubHeaders";
+  std::vector< std::string > headers;
+  std::vector< std::string > options;
+
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( ( argument.compare( "--cppproject" ) == 0 ) && ( i + 1 < argc ) ) {
+      executable = argv[++i];
+    } else if ( ( argument.compare( "--stub-includes" ) == 0 ) && ( i + 1 < argc ) ) {
+      stubIncludes = argv[++i];
+    } else if ( argument.compare( "--" ) == 0 ) {
+      options.assign( argv + i + 1, argv + argc );
+      break;
+    } else if ( argument.compare( 0, 2, "--" ) != 0 ) {
+      headers.emplace_back( argument );
+    } else {
+      std::cerr << "Usage: " << argv[0]
+                << " [--cppproject <path>] [--stub-includes <directory>]"
+                   " [<header|directory>...] [-- <options of CPPProject>...]\n";
+      return EXIT_FAILURE;
+    }
+  }
+  if ( headers.empty( ) ) {
+    headers.emplace_back( CPPPROJECT_SOURCE_DIR "/TestVectors/Component.hpp" );
+  }
+  if ( options.empty( ) ) {
+    options = { "--jobs", "1" };
+  }
+
+  const char *temporary = std::getenv( "TMPDIR" );
+  std::string outputFile
+      = std::string( ( temporary != nullptr ) ? temporary : "/tmp" ) + "/ParseProfileBenchmark.XXXXXX";
+  const int descriptor = mkstemp( &outputFile[0] );
+  if ( descriptor < 0 ) {
+    std::cerr << "Unable to create a temporary file.\n";
+    return EXIT_FAILURE;
+  }
+  close( descriptor );
+
+  std::cout << "CPPProject:   " << executable << "\n";
+  std::cout << "Stub headers: " << stubIncludes << "\n\n";
+  std::cout << std::left << std::setw( 14 ) << "Profile" << std::right << std::setw( 12 )
+            << "Parse (ms)" << std::setw( 18 ) << "libclang (MB)" << std::setw( 12 ) << "Seconds"
+            << std::setw( 16 ) << "Peak RSS (MB)"
+            << "  Output\n";
+
+  bool isSuccessful = true;
+  std::string reference;
+  for ( const Configuration &configuration : configurations ) {
+    std::vector< std::string > arguments( options );
+    arguments.insert( arguments.end( ),
+                      { "--profile", "json", "--parse-profile", configuration._parseProfile } );
+    if ( configuration._isStubbed ) {
+      arguments.insert( arguments.end( ), { "--stub-includes", stubIncludes } );
+    }
+    arguments.insert( arguments.end( ), headers.begin( ), headers.end( ) );
+
+    RomanoViolet::ChildProcessResult result;
+    std::string verdict;
+    if ( !RomanoViolet::RunChildProcess( executable, arguments, outputFile, result ) ) {
+      verdict = "failed";
+      isSuccessful = false;
+    } else if ( reference.empty( ) ) {
+      reference = readFile( outputFile );
+      verdict = "reference";
+    } else {
+      verdict = ( readFile( outputFile ) == reference ) ? "same" : "differs";
+    }
+
+    // the profile is the last line written to stderr.
+    const std::size_t profile = result._errors.rfind( "{\"phases\":" );
+    const std::string json
+        = ( profile == std::string::npos ) ? std::string( ) : result._errors.substr( profile );
+    const double parseMilliseconds
+        = readNumber( json, "\"ms\":", json.find( "\"parse\":" ) );
+    const double libclangBytes = readNumber( json, "\"memory_total\":" );
+
+    std::cout << std::fixed << std::left << std::setw( 14 ) << configuration._name << std::right
+              << std::setprecision( 1 ) << std::setw( 12 ) << parseMilliseconds << std::setw( 18 )
+              << libclangBytes / ( 1024.0 * 1024.0 ) << std::setprecision( 3 ) << std::setw( 12 )
+              << result._seconds << std::setprecision( 1 ) << std::setw( 16 )
+              << static_cast< double >( result._peakResidentKilobytes ) / 1024.0 << "  " << verdict
+              << "\n";
+  }
+
+  unlink( outputFile.c_str( ) );
+  return isSuccessful ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,113 @@
+/**
+ * @file ReplayCursorLog.cpp
+ * @brief Runs RomanoViolet::StateMachine over a cursor log recorded with CPPProject --record,
+ * without parsing anything: libclang is linked, but not called.
+ * @details The results are written to stdout exactly as CPPProject writes them, so that they can be
+ * compared with the output of the recording run, e.g., after the rules of the state machine have
+ * changed. The replay is then repeated, and the time per cursor is reported on stderr.
+ *
+ * Usage: ReplayCursorLog [--format <text|jsonl|binary>] [--repetitions <n>] <log>
+ */
+
+#include "Application/CursorLog.hpp"
+#include "Application/ResultSink.hpp"
+#include "Application/StateMachine.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::size_t replay( const RomanoViolet::RecordedHeader &header,
+                      RomanoViolet::ResultSink *sink )
+  {
+    RomanoViolet::StateMachine p{ header._classToInspect, header._inspectAllClasses };
+    for ( const RomanoViolet::CursorEvent &event : header._events ) {
+      p.AdvanceStateMachine( RomanoViolet::Cursor( event ) );
+    }
+    const std::vector< RomanoViolet::StateMachine::ClassDetails > inspectedClasses
+        = p.GetInspectedClasses( );
+    if ( sink != nullptr ) {
+      sink->BeginHeader( header._header );
+      for ( const RomanoViolet::StateMachine::ClassDetails &classDetails : inspectedClasses ) {
+        sink->WriteClass( header._header, classDetails );
+      }
+    }
+    return inspectedClasses.size( );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  RomanoViolet::OutputFormat format = RomanoViolet::OutputFormat::TEXT;
+  unsigned long repetitions = 100;
+  std::string log;
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( ( argument.compare( "--format" ) == 0 ) && ( i + 1 < argc ) ) {
+      if ( !RomanoViolet::ParseOutputFormat( argv[++i], format ) ) {
+        std::cerr << "Unknown output format: " << argv[i] << "\n";
+        return EXIT_FAILURE;
+      }
+    } else if ( ( argument.compare( "--repetitions" ) == 0 ) && ( i + 1 < argc ) ) {
+      repetitions = std::strtoul( argv[++i], nullptr, 10 );
+    } else if ( log.empty( ) && ( argument.compare( 0, 2, "--" ) != 0 ) ) {
+      log = argument;
+    } else {
+      log.clear( );
+      break;
+    }
+  }
+  if ( log.empty( ) ) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--format <text|jsonl|binary>] [--repetitions <n>] <log>\n";
+    return EXIT_FAILURE;
+  }
+
+  std::vector< std::unique_ptr< RomanoViolet::RecordedHeader > > headers;
+  if ( !RomanoViolet::ReadCursorLog( log, headers ) ) {
+    std::cerr << "Unable to read cursor log: " << log << "\n";
+    return EXIT_FAILURE;
+  }
+
+  {
+    // labelled as by CPPProject, which labels the output of every header if given several.
+    RomanoViolet::BufferedWriter writer( std::cout );
+    const std::unique_ptr< RomanoViolet::ResultSink > sink
+        = RomanoViolet::MakeResultSink( format, writer, /*labelHeaders=*/headers.size( ) > 1 );
+    for ( const std::unique_ptr< RomanoViolet::RecordedHeader > &header : headers ) {
+      replay( *header, sink.get( ) );
+    }
+  }
+  std::cout.flush( );
+
+  std::size_t events = 0;
+  for ( const std::unique_ptr< RomanoViolet::RecordedHeader > &header : headers ) {
+    events += header->_events.size( );
+  }
+
+  std::size_t classes = 0;
+  const Clock::time_point start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    for ( const std::unique_ptr< RomanoViolet::RecordedHeader > &header : headers ) {
+      classes += replay( *header, nullptr );
+    }
+  }
+  const double seconds = std::chrono::duration< double >( Clock::now( ) - start ).count( );
+
+  if ( ( repetitions > 0 ) && ( events > 0 ) ) {
+    std::cerr << "Headers:      " << headers.size( ) << " (" << classes / repetitions
+              << " classes)\n";
+    std::cerr << "Cursors:      " << events << " x " << repetitions << " repetitions\n";
+    std::cerr << "replay:       " << seconds * 1e9 / static_cast< double >( events * repetitions )
+              << " ns/cursor, "
+              << static_cast< double >( headers.size( ) * repetitions ) / seconds
+              << " headers/s\n";
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,334 @@
+/**
+ * @file SafeTypeArithmeticBenchmark.cpp
+ * @brief Measures the saturating addition and subtraction of SafeType against the if/else-if
+ * chains they replaced, and the fused evaluation of a + b - c + d.
+ * @details A running sum within [-0.5, 0.5] over random deltas, a good part of the steps leaving
+ * the bounds at random, such that the branches of a chain are mispredicted often. Three loops are
+ * timed:
+ *  - chain: the former operator+ and operator-, reproduced below on a plain float and error code.
+ *  - compound: SafeType::operator+= and SafeType::operator-=.
+ *  - binary: sum = sum + delta and sum = sum - delta.
+ * The sums of the chain and of SafeType are compared at every step; they differ only where the
+ * chain left the sum unchanged, i.e., on a bound exactly.
+ *
+ * Beforehand, +, -, +=, -= and a + b - c + d are checked, for both SafeType implementations, over
+ * operands whose sums and differences are NaN, exactly on a bound, or beyond one: the result must
+ * be the one of the constructor from the float result, bit by bit, i.e., NaN, or the bound, with
+ * NO_ERROR, where the chain left the sum and its error code untouched.
+ *
+ * Then a + b - c + d over four consecutive deltas, the result being compared bit by bit with the
+ * reference semantics of SafeTypesExpression.hpp, BoundedType( ( ( a + b ) - c ) + d ) on floats.
+ * Two loops are timed:
+ *  - stepwise: a copy of a, then +=, -= and +=, clamping after every operation.
+ *  - fused: the expression, clamped once, on assignment.
+ *
+ * Usage: SafeTypeArithmeticBenchmark [--check] [deltas] [repetitions]
+ *
+ * With --check, only the results are checked, over 2^16 deltas by default, and nothing is timed.
+ */
+
+#include <BoundedTypes/SafeTypes.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  using RomanoViolet::SafeTypeErrorCode;
+
+  using BoundedType = RomanoViolet::SafeType< -1, 2, 1, 2 >;
+  // [-1, 1], the fixed-type implementation.
+  using WholeBoundsType = RomanoViolet::SafeType< -1, 1, 1, 1 >;
+  constexpr float lowerBound = -0.5F;
+  constexpr float upperBound = 0.5F;
+
+  // The former SafeType::operator+, on a value and its error code.
+  void chainAdd( float &value, SafeTypeErrorCode &errorCode, float other )
+  {
+    if ( ( value + other < upperBound ) && ( value + other > lowerBound ) ) {
+      value += other;
+      errorCode = SafeTypeErrorCode::NO_ERROR;
+    } else if ( value + other > upperBound ) {
+      value = upperBound;
+      errorCode = SafeTypeErrorCode::OVERFLOW;
+    } else if ( value + other < lowerBound ) {
+      value = lowerBound;
+      errorCode = SafeTypeErrorCode::UNDERFLOW;
+    }
+  }
+
+  // The former SafeType::operator-, on a value and its error code.
+  void chainSubtract( float &value, SafeTypeErrorCode &errorCode, float other )
+  {
+    if ( ( value - other > lowerBound ) && ( value - other < upperBound ) ) {
+      value -= other;
+      errorCode = SafeTypeErrorCode::NO_ERROR;
+    } else if ( value - other > upperBound ) {
+      value = upperBound;
+      errorCode = SafeTypeErrorCode::OVERFLOW;
+    } else if ( value - other < lowerBound ) {
+      value = lowerBound;
+      errorCode = SafeTypeErrorCode::UNDERFLOW;
+    }
+  }
+
+  bool isSameFloat( float left, float right )
+  {
+    return std::memcmp( &left, &right, sizeof( float ) ) == 0;
+  }
+
+  // Operands of the check: pairs of them sum to NaN, to either bound of either type exactly, or
+  // beyond. The constructor keeps a NaN, and turns the infinities into the bounds.
+  std::vector< float > specialValues( )
+  {
+    const float infinity = std::numeric_limits< float >::infinity( );
+    return { std::numeric_limits< float >::quiet_NaN( ),
+             -std::numeric_limits< float >::quiet_NaN( ),
+             infinity,
+             -infinity,
+             0.0F,
+             -0.0F,
+             0.25F,
+             -0.25F,
+             0.5F,
+             -0.5F,
+             0.75F,
+             -0.75F,
+             1.0F,
+             -1.0F,
+             std::nextafter( 0.5F, 0.0F ),
+             std::nextafter( -0.5F, 0.0F ),
+             std::nextafter( 1.0F, 0.0F ),
+             std::numeric_limits< float >::denorm_min( ) };
+  }
+
+  // Whether result holds what SafeTypeT( value ) holds, value being the float result. Any NaN
+  // is as good as another: which operand's NaN a sum of two NaNs is, is up to the compiler.
+  template < typename SafeTypeT >
+  bool isAsConstructed( const SafeTypeT &result, float value )
+  {
+    const SafeTypeT reference( value );
+    const bool isSameValue
+        = ( std::isnan( result.getValue( ) ) && std::isnan( reference.getValue( ) ) )
+          || isSameFloat( result.getValue( ), reference.getValue( ) );
+    return isSameValue && ( result.getErrorCode( ) == reference.getErrorCode( ) );
+  }
+
+  // The number of results of +, -, +=, -= and a + b - c + d over the special values which differ
+  // from the constructor from the float result.
+  template < typename SafeTypeT >
+  std::size_t checkSpecialValues( )
+  {
+    std::vector< SafeTypeT > operands;
+    for ( const float value : specialValues( ) ) {
+      operands.emplace_back( value );
+    }
+
+    std::size_t mismatches = 0;
+    for ( const SafeTypeT &a : operands ) {
+      for ( const SafeTypeT &b : operands ) {
+        const float sum = a.getValue( ) + b.getValue( );
+        const float difference = a.getValue( ) - b.getValue( );
+        SafeTypeT compound( a );
+        compound += b;
+        mismatches += isAsConstructed( compound, sum ) ? 0 : 1;
+        compound = a;
+        compound -= b;
+        mismatches += isAsConstructed( compound, difference ) ? 0 : 1;
+        mismatches += isAsConstructed( SafeTypeT( a + b ), sum ) ? 0 : 1;
+        mismatches += isAsConstructed( SafeTypeT( a - b ), difference ) ? 0 : 1;
+
+        for ( const SafeTypeT &c : operands ) {
+          for ( const SafeTypeT &d : operands ) {
+            const SafeTypeT fused = a + b - c + d;
+            mismatches += isAsConstructed( fused, ( sum - c.getValue( ) ) + d.getValue( ) ) ? 0 : 1;
+          }
+        }
+      }
+    }
+    return mismatches;
+  }
+
+  double nanosecondsPer( Clock::duration duration, std::size_t count )
+  {
+    return std::chrono::duration< double, std::nano >( duration ).count( )
+           / static_cast< double >( count );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  const bool isCheckOnly = ( argc > 1 ) && ( std::strcmp( argv[1], "--check" ) == 0 );
+  if ( isCheckOnly ) {
+    --argc;
+    ++argv;
+  }
+  const unsigned long defaultDeltas = isCheckOnly ? 1UL << 16 : 1UL << 20;
+  const unsigned long numberOfDeltas
+      = std::max( 2UL, ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : defaultDeltas );
+  const unsigned long repetitions
+      = std::max( 1UL, ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 20UL );
+
+  // Deltas are within the bounds, and added to and subtracted from the sum in turns.
+  std::mt19937 generator( 1 );
+  std::uniform_real_distribution< float > distribution( lowerBound, upperBound );
+  std::vector< float > deltas;
+  std::vector< BoundedType > safeDeltas;
+  deltas.reserve( numberOfDeltas );
+  safeDeltas.reserve( numberOfDeltas );
+  for ( unsigned long i = 0; i < numberOfDeltas; ++i ) {
+    deltas.push_back( BoundedType( distribution( generator ) ).getValue( ) );
+    safeDeltas.emplace_back( deltas.back( ) );
+  }
+
+  // Where the results differ from the constructor on special values, or from the chain other than
+  // on a bound.
+  std::size_t mismatches = checkSpecialValues< BoundedType >( );
+  mismatches += checkSpecialValues< WholeBoundsType >( );
+  {
+    float value = 0.0F;
+    SafeTypeErrorCode errorCode = SafeTypeErrorCode::NO_ERROR;
+    BoundedType sum( 0.0F );
+    for ( unsigned long i = 0; i + 1 < numberOfDeltas; i += 2 ) {
+      const float expected = value + deltas[i];
+      chainAdd( value, errorCode, deltas[i] );
+      sum += safeDeltas[i];
+      const bool isOnBound = ( expected == lowerBound ) || ( expected == upperBound );
+      if ( !isOnBound
+           && ( ( sum.getValue( ) != value ) || ( sum.getErrorCode( ) != errorCode ) ) ) {
+        ++mismatches;
+      }
+      value = sum.getValue( );
+      errorCode = sum.getErrorCode( );
+
+      const float expectedDifference = value - deltas[i + 1];
+      chainSubtract( value, errorCode, deltas[i + 1] );
+      sum -= safeDeltas[i + 1];
+      const bool isDifferenceOnBound
+          = ( expectedDifference == lowerBound ) || ( expectedDifference == upperBound );
+      if ( !isDifferenceOnBound
+           && ( ( sum.getValue( ) != value ) || ( sum.getErrorCode( ) != errorCode ) ) ) {
+        ++mismatches;
+      }
+      value = sum.getValue( );
+      errorCode = sum.getErrorCode( );
+    }
+  }
+
+  // a + b - c + d, where the fused result differs from the reference.
+  for ( unsigned long i = 0; i + 3 < numberOfDeltas; i += 4 ) {
+    const BoundedType fused
+        = safeDeltas[i] + safeDeltas[i + 1] - safeDeltas[i + 2] + safeDeltas[i + 3];
+    const float value = ( ( deltas[i] + deltas[i + 1] ) - deltas[i + 2] ) + deltas[i + 3];
+    const BoundedType reference( value );
+    if ( !isSameFloat( fused.getValue( ), reference.getValue( ) )
+         || ( fused.getErrorCode( ) != reference.getErrorCode( ) ) ) {
+      ++mismatches;
+    }
+  }
+
+  if ( isCheckOnly ) {
+    std::cout << "Mismatches:   " << mismatches
+              << " (special values, off the bounds, or to the reference)\n";
+    return ( mismatches == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  // chain
+  std::size_t errors = 0;
+  Clock::time_point start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    float value = 0.0F;
+    SafeTypeErrorCode errorCode = SafeTypeErrorCode::NO_ERROR;
+    for ( unsigned long i = 0; i + 1 < numberOfDeltas; i += 2 ) {
+      chainAdd( value, errorCode, deltas[i] );
+      errors += ( errorCode != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+      chainSubtract( value, errorCode, deltas[i + 1] );
+      errors += ( errorCode != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+    }
+  }
+  const Clock::duration chain = Clock::now( ) - start;
+  const std::size_t chainErrors = errors;
+
+  // compound
+  errors = 0;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    BoundedType sum( 0.0F );
+    for ( unsigned long i = 0; i + 1 < numberOfDeltas; i += 2 ) {
+      sum += safeDeltas[i];
+      errors += ( sum.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+      sum -= safeDeltas[i + 1];
+      errors += ( sum.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+    }
+  }
+  const Clock::duration compound = Clock::now( ) - start;
+  const std::size_t compoundErrors = errors;
+
+  // binary
+  errors = 0;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    BoundedType sum( 0.0F );
+    for ( unsigned long i = 0; i + 1 < numberOfDeltas; i += 2 ) {
+      sum = sum + safeDeltas[i];
+      errors += ( sum.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+      sum = sum - safeDeltas[i + 1];
+      errors += ( sum.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+    }
+  }
+  const Clock::duration binary = Clock::now( ) - start;
+  const std::size_t binaryErrors = errors;
+
+  // stepwise
+  errors = 0;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    for ( unsigned long i = 0; i + 3 < numberOfDeltas; i += 4 ) {
+      BoundedType result( safeDeltas[i] );
+      result += safeDeltas[i + 1];
+      result -= safeDeltas[i + 2];
+      result += safeDeltas[i + 3];
+      errors += ( result.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+    }
+  }
+  const Clock::duration stepwise = Clock::now( ) - start;
+  const std::size_t stepwiseErrors = errors;
+
+  // fused
+  errors = 0;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    for ( unsigned long i = 0; i + 3 < numberOfDeltas; i += 4 ) {
+      const BoundedType result
+          = safeDeltas[i] + safeDeltas[i + 1] - safeDeltas[i + 2] + safeDeltas[i + 3];
+      errors += ( result.getErrorCode( ) != SafeTypeErrorCode::NO_ERROR ) ? 1 : 0;
+    }
+  }
+  const Clock::duration fused = Clock::now( ) - start;
+  const std::size_t fusedErrors = errors;
+
+  const std::size_t count = ( numberOfDeltas / 2 ) * 2 * repetitions;
+  const std::size_t chainCount = ( numberOfDeltas / 4 ) * repetitions;
+  std::cout << "Operations:   " << ( numberOfDeltas / 2 ) * 2 << " x " << repetitions
+            << " repetitions\n";
+  std::cout << "Mismatches:   " << mismatches
+            << " (special values, off the bounds, or to the reference)\n";
+  std::cout << "chain:        " << nanosecondsPer( chain, count ) << " ns/operation ("
+            << chainErrors / repetitions << " saturated per repetition)\n";
+  std::cout << "compound:     " << nanosecondsPer( compound, count ) << " ns/operation ("
+            << compoundErrors / repetitions << " saturated per repetition)\n";
+  std::cout << "binary:       " << nanosecondsPer( binary, count ) << " ns/operation ("
+            << binaryErrors / repetitions << " saturated per repetition)\n";
+  std::cout << "stepwise:     " << nanosecondsPer( stepwise, chainCount ) << " ns/chain ("
+            << stepwiseErrors / repetitions << " saturated per repetition)\n";
+  std::cout << "fused:        " << nanosecondsPer( fused, chainCount ) << " ns/chain ("
+            << fusedErrors / repetitions << " saturated per repetition)\n";
+  return ( mismatches == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
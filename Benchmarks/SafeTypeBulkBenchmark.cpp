@@ -0,0 +1,202 @@
+/**
+ * @file SafeTypeBulkBenchmark.cpp
+ * @brief Measures clampToBounds( ) against constructing one SafeType per value, after checking
+ * that both give the same results.
+ * @details The check compares, element by element and bit by bit, the clamped values and error
+ * codes of clampToBounds< T >( ) with those of T( values[i] ), as well as the returned mask with
+ * the error codes or-ed together. It covers NaN, infinities, signed zeros, values on a bound and
+ * next to it, spans of 0 to 9 values starting at every offset into a block of four, in place and
+ * out of place, with and without error codes, for bounds of either SafeType implementation.
+ *
+ * Usage: SafeTypeBulkBenchmark [--check] [values] [repetitions]
+ *
+ * With --check, only the results are checked, and nothing is timed.
+ */
+
+#include <BoundedTypes/CustomTypes.hpp>
+#include <BoundedTypes/SafeTypesBulk.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+  using RomanoViolet::SafeTypeErrorCode;
+
+  // [-3, 2], the fixed-type implementation.
+  using WholeBoundsType = RomanoViolet::SafeType< -3, 1, 2, 1 >;
+
+  bool isSameFloat( float left, float right )
+  {
+    return std::memcmp( &left, &right, sizeof( float ) ) == 0;
+  }
+
+  // Values which are a problem for one comparison or another, around the bounds of SafeTypeT.
+  template < typename SafeTypeT >
+  std::vector< float > specialValues( )
+  {
+    const float lowerBound = RomanoViolet::SafeTypeBounds< SafeTypeT >::lowerBound( );
+    const float upperBound = RomanoViolet::SafeTypeBounds< SafeTypeT >::upperBound( );
+    const float infinity = std::numeric_limits< float >::infinity( );
+    return { std::numeric_limits< float >::quiet_NaN( ),
+             -std::numeric_limits< float >::quiet_NaN( ),
+             infinity,
+             -infinity,
+             0.0F,
+             -0.0F,
+             lowerBound,
+             upperBound,
+             std::nextafter( lowerBound, -infinity ),
+             std::nextafter( lowerBound, infinity ),
+             std::nextafter( upperBound, -infinity ),
+             std::nextafter( upperBound, infinity ),
+             ( lowerBound + upperBound ) / 2.0F,
+             std::numeric_limits< float >::max( ),
+             std::numeric_limits< float >::lowest( ),
+             std::numeric_limits< float >::denorm_min( ) };
+  }
+
+  // The number of values of values[begin, begin + count) clamped differently from SafeTypeT, plus
+  // one if the mask differs.
+  template < typename SafeTypeT >
+  std::size_t countMismatches( const std::vector< float > &values,
+                               std::size_t begin,
+                               std::size_t count,
+                               bool isInPlace,
+                               bool withErrorCodes )
+  {
+    // in place, clamped is the input as well. Out of place, it starts as a copy of the input,
+    // such that values outside the span compare equal unless they are written.
+    std::vector< float > clamped( values );
+    std::vector< SafeTypeErrorCode > errorCodes( values.size( ), SafeTypeErrorCode::NO_ERROR );
+    const float *input = isInPlace ? clamped.data( ) : values.data( );
+    const unsigned mask = RomanoViolet::clampToBounds< SafeTypeT >(
+        input + begin,
+        clamped.data( ) + begin,
+        count,
+        withErrorCodes ? errorCodes.data( ) + begin : nullptr );
+
+    std::size_t mismatches = 0;
+    unsigned expectedMask = 0U;
+    for ( std::size_t i = begin; i < begin + count; ++i ) {
+      const SafeTypeT expected( values[i] );
+      expectedMask |= static_cast< unsigned >( expected.getErrorCode( ) );
+      if ( !isSameFloat( clamped[i], expected.getValue( ) )
+           || ( withErrorCodes && ( errorCodes[i] != expected.getErrorCode( ) ) ) ) {
+        ++mismatches;
+      }
+    }
+    // values outside the span are left alone.
+    for ( std::size_t i = 0; i < values.size( ); ++i ) {
+      if ( ( ( i < begin ) || ( i >= begin + count ) ) && !isSameFloat( clamped[i], values[i] ) ) {
+        ++mismatches;
+      }
+    }
+    return mismatches + ( ( mask != expectedMask ) ? 1 : 0 );
+  }
+
+  template < typename SafeTypeT >
+  std::size_t check( const std::vector< float > &randomValues )
+  {
+    std::size_t mismatches = 0;
+    const std::vector< float > special = specialValues< SafeTypeT >( );
+    for ( int variant = 0; variant < 4; ++variant ) {
+      const bool isInPlace = ( variant & 1 ) != 0;
+      const bool withErrorCodes = ( variant & 2 ) != 0;
+      // every special value in every lane, and in the scalar remainder.
+      for ( std::size_t begin = 0; begin < 4; ++begin ) {
+        for ( std::size_t count = 0; count <= 9; ++count ) {
+          for ( std::size_t shift = 0; shift < special.size( ); ++shift ) {
+            std::vector< float > values( 16 );
+            for ( std::size_t i = 0; i < values.size( ); ++i ) {
+              values[i] = special[( i + shift ) % special.size( )];
+            }
+            mismatches += countMismatches< SafeTypeT >(
+                values, begin, count, isInPlace, withErrorCodes );
+          }
+        }
+      }
+      mismatches += countMismatches< SafeTypeT >(
+          randomValues, 1, randomValues.size( ) - 1, isInPlace, withErrorCodes );
+    }
+    return mismatches;
+  }
+
+  double millisecondsPer( Clock::duration duration, std::size_t count )
+  {
+    return std::chrono::duration< double, std::milli >( duration ).count( )
+           / static_cast< double >( count );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  const bool isCheckOnly = ( argc > 1 ) && ( std::strcmp( argv[1], "--check" ) == 0 );
+  if ( isCheckOnly ) {
+    --argc;
+    ++argv;
+  }
+  const unsigned long numberOfValues
+      = std::max( 1UL, ( argc > 1 ) ? std::strtoul( argv[1], nullptr, 10 ) : 1UL << 20 );
+  const unsigned long repetitions
+      = std::max( 1UL, ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 50UL );
+
+  // Two thirds of the values are beyond either bound of VelocityType, at random.
+  std::mt19937 generator( 1 );
+  std::uniform_real_distribution< float > distribution( 0.25F, 1.0F );
+  std::vector< float > values( numberOfValues );
+  for ( float &value : values ) {
+    value = distribution( generator );
+  }
+
+  // the check runs on fewer values: it copies them per variant.
+  const std::vector< float > checkedValues(
+      values.begin( ), values.begin( ) + std::min( numberOfValues, 4099UL ) );
+  std::size_t mismatches = check< VelocityType >( checkedValues );
+  mismatches += check< CountingType >( checkedValues );
+  mismatches += check< WholeBoundsType >( checkedValues );
+  if ( isCheckOnly ) {
+    std::cout << "Mismatches:   " << mismatches << "\n";
+    return ( mismatches == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
+  std::vector< float > clamped( numberOfValues );
+  std::vector< SafeTypeErrorCode > errorCodes( numberOfValues );
+
+  // bulk
+  unsigned mask = 0U;
+  Clock::time_point start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    mask |= RomanoViolet::clampToBounds< VelocityType >(
+        values.data( ), clamped.data( ), numberOfValues, errorCodes.data( ) );
+  }
+  const Clock::duration bulk = Clock::now( ) - start;
+
+  // one SafeType per value
+  unsigned scalarMask = 0U;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    for ( unsigned long i = 0; i < numberOfValues; ++i ) {
+      const VelocityType value( values[i] );
+      clamped[i] = value.getValue( );
+      errorCodes[i] = value.getErrorCode( );
+      scalarMask |= static_cast< unsigned >( errorCodes[i] );
+    }
+  }
+  const Clock::duration scalar = Clock::now( ) - start;
+
+  std::cout << "Values:       " << numberOfValues << " x " << repetitions << " repetitions\n";
+  std::cout << "Mismatches:   " << mismatches << "\n";
+  std::cout << "bulk:         " << millisecondsPer( bulk, repetitions ) << " ms (mask " << mask
+            << ")\n";
+  std::cout << "per value:    " << millisecondsPer( scalar, repetitions ) << " ms (mask "
+            << scalarMask << ")\n";
+  return ( mismatches == 0 ) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,135 @@
+/**
+ * @file StateMachineBenchmark.cpp
+ * @brief Measures the per-cursor cost of RomanoViolet::StateMachine.
+ * @details The header is parsed once, and all cursors of the translation unit are collected in
+ * traversal order. Afterwards, two loops are timed over the collected cursors, so that neither
+ * parsing nor the traversal by libclang is part of the measurement:
+ *  - transition: StateMachine::GetNewState only, i.e., the lookup of the next state.
+ *  - advance: StateMachine::AdvanceStateMachine, i.e., the lookup plus the in-state actions.
+ *
+ * Usage: StateMachineBenchmark [header] [repetitions]
+ */
+
+#include "Application/StateMachine.hpp"
+#include <algorithm>
+#include <chrono>
+#include <clang-c/Index.h>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using Clock = std::chrono::steady_clock;
+
+  CXChildVisitResult collect( CXCursor cursor, CXCursor parent, CXClientData clientData )
+  {
+    ( void )parent;
+    static_cast< std::vector< CXCursor > * >( clientData )->emplace_back( cursor );
+    return CXChildVisit_Recurse;
+  }
+
+  // Same mapping as StateMachine::AdvanceStateMachine.
+  RomanoViolet::StateMachine::Event toEvent( const CXCursor cursor )
+  {
+    using Event = RomanoViolet::StateMachine::Event;
+    switch ( clang_getCursorKind( cursor ) ) {
+      case CXCursorKind::CXCursor_Namespace:
+        return Event::NAMESPACE;
+      case CXCursorKind::CXCursor_ClassDecl:
+        return Event::CLASS_DECLARATION;
+      case CXCursorKind::CXCursor_CXXBaseSpecifier:
+        return Event::BASECLASS_SPECIFIER;
+      case CXCursorKind::CXCursor_TypeRef:
+        return Event::TYPEREF;
+      case CXCursorKind::CXCursor_FieldDecl:
+        return Event::FIELD_DECLARATION;
+      case CXCursorKind::CXCursor_NamespaceRef:
+        return Event::NAME_SPACE_REFERENCE;
+      case CXCursorKind::CXCursor_TemplateRef:
+        return Event::TEMPLATE_REFERENCE;
+      default:
+        return Event::OTHERS;
+    }
+  }
+
+  double nanosecondsPer( Clock::duration duration, std::size_t count )
+  {
+    return std::chrono::duration< double, std::nano >( duration ).count( )
+           / static_cast< double >( count );
+  }
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  const std::string header
+      = ( argc > 1 ) ? argv[1] : std::string( CPPPROJECT_SOURCE_DIR ) + "/TestVectors/Component.hpp";
+  const unsigned long repetitions
+      = std::max( 1UL, ( argc > 2 ) ? std::strtoul( argv[2], nullptr, 10 ) : 20UL );
+
+  const std::string includeDirectory
+      = std::string( "-I" ) + CPPPROJECT_SOURCE_DIR + "/CoreFunctions";
+  const char *arguments[] = { "-x", "c++", "-std=c++11", includeDirectory.c_str( ) };
+
+  CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                     /*displayDiagnostics=*/false );
+  CXTranslationUnit tu = clang_parseTranslationUnit(
+      index,
+      /*source_filename=*/header.c_str( ),
+      /*command_line_args=*/arguments,
+      /*num_command_line_args=*/sizeof( arguments ) / sizeof( arguments[0] ),
+      /*unsaved_files=*/nullptr,
+      /*num_unsaved_files=*/0,
+      /*options=*/CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
+          | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete );
+  if ( tu == nullptr ) {
+    std::cerr << "Unable to parse translation unit: " << header << "\n";
+    clang_disposeIndex( index );
+    return EXIT_FAILURE;
+  }
+
+  std::vector< CXCursor > cursors;
+  clang_visitChildren( clang_getTranslationUnitCursor( tu ), collect, &cursors );
+
+  std::vector< RomanoViolet::StateMachine::Event > events;
+  events.reserve( cursors.size( ) );
+  for ( const CXCursor &cursor : cursors ) {
+    events.emplace_back( toEvent( cursor ) );
+  }
+
+  // transition: the state is carried from one lookup to the next, so the lookups cannot be
+  // hoisted or reordered.
+  RomanoViolet::StateMachine::State state = RomanoViolet::StateMachine::State::INIT;
+  Clock::time_point start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    for ( const RomanoViolet::StateMachine::Event event : events ) {
+      state = RomanoViolet::StateMachine::GetNewState( state, event );
+    }
+  }
+  const Clock::duration transition = Clock::now( ) - start;
+
+  // advance: a fresh state machine per repetition, discovering the class as in --single-pass.
+  std::size_t collectedIO = 0;
+  start = Clock::now( );
+  for ( unsigned long repetition = 0; repetition < repetitions; ++repetition ) {
+    RomanoViolet::StateMachine p{ "" };
+    for ( const CXCursor &cursor : cursors ) {
+      p.AdvanceStateMachine( cursor );
+    }
+    collectedIO += p.GetInspectedClasses( ).front( )._io.size( );
+  }
+  const Clock::duration advance = Clock::now( ) - start;
+
+  const std::size_t count = cursors.size( ) * repetitions;
+  std::cout << "Header:       " << header << "\n";
+  std::cout << "Cursors:      " << cursors.size( ) << " x " << repetitions << " repetitions\n";
+  std::cout << "transition:   " << nanosecondsPer( transition, count ) << " ns/cursor"
+            << " (final state " << static_cast< int >( state ) << ")\n";
+  std::cout << "advance:      " << nanosecondsPer( advance, count ) << " ns/cursor"
+            << " (" << collectedIO / repetitions << " IO per repetition)\n";
+
+  clang_disposeTranslationUnit( tu );
+  clang_disposeIndex( index );
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,101 @@
+# Convenience function to be called from the main CMakeLists.txt
+function(buildBenchmarks)
+
+  # Benchmarks are built alongside CPPProject, but are not run as tests: timings
+  # depend on the machine.
+
+  # System Headers
+  include_directories("/usr/lib/llvm-11/include")
+  include_directories(${PROJECT_SOURCE_DIR}/CoreFunctions)
+  link_directories("/usr/lib/llvm-11/lib/")
+
+  # Per-cursor cost of the state machine.
+  add_executable(
+    StateMachineBenchmark
+    ${PROJECT_SOURCE_DIR}/Benchmarks/StateMachineBenchmark.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Cursor.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Instrumentation.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/ResultSink.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StateMachine.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StringPool.cpp)
+  target_compile_definitions(
+    StateMachineBenchmark
+    PRIVATE CPPPROJECT_SOURCE_DIR="${PROJECT_SOURCE_DIR}")
+  target_link_libraries(StateMachineBenchmark clang)
+  set_target_properties(StateMachineBenchmark PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # The state machine over a recorded cursor log, without parsing.
+  add_executable(
+    ReplayCursorLog
+    ${PROJECT_SOURCE_DIR}/Benchmarks/ReplayCursorLog.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Cursor.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/CursorLog.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Instrumentation.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/ResultSink.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StateMachine.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StringPool.cpp)
+  target_link_libraries(ReplayCursorLog clang)
+  set_target_properties(ReplayCursorLog PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # Synthetic corpora of component headers.
+  add_executable(
+    GenerateCorpus ${PROJECT_SOURCE_DIR}/Benchmarks/GenerateCorpus.cpp
+                   ${PROJECT_SOURCE_DIR}/Benchmarks/CorpusGenerator.cpp)
+  set_target_properties(GenerateCorpus PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # CPPProject end to end, over corpora of increasing size.
+  add_executable(
+    ExtractionBenchmark ${PROJECT_SOURCE_DIR}/Benchmarks/ExtractionBenchmark.cpp
+                        ${PROJECT_SOURCE_DIR}/Benchmarks/ChildProcess.cpp
+                        ${PROJECT_SOURCE_DIR}/Benchmarks/CorpusGenerator.cpp)
+  target_compile_definitions(
+    ExtractionBenchmark
+    PRIVATE CPPPROJECT_EXECUTABLE="$<TARGET_FILE:CPPProject>")
+  add_dependencies(ExtractionBenchmark CPPProject)
+  set_target_properties(ExtractionBenchmark PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # Parse time and libclang memory of CPPProject per parse profile, with and
+  # without stub headers.
+  add_executable(
+    ParseProfileBenchmark ${PROJECT_SOURCE_DIR}/Benchmarks/ParseProfileBenchmark.cpp
+                          ${PROJECT_SOURCE_DIR}/Benchmarks/ChildProcess.cpp)
+  target_compile_definitions(
+    ParseProfileBenchmark
+    PRIVATE CPPPROJECT_EXECUTABLE="$<TARGET_FILE:CPPProject>"
+            CPPPROJECT_SOURCE_DIR="${PROJECT_SOURCE_DIR}")
+  add_dependencies(ParseProfileBenchmark CPPProject)
+  set_target_properties(ParseProfileBenchmark PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # The output of CPPProject --fast against the regular extraction, over
+  # generated corpora and headers on which the fast path falls back. Unlike the
+  # benchmarks, the check does not depend on timings, and runs as a test.
+  add_executable(
+    FastPathCheck ${PROJECT_SOURCE_DIR}/Benchmarks/FastPathCheck.cpp
+                  ${PROJECT_SOURCE_DIR}/Benchmarks/ChildProcess.cpp
+                  ${PROJECT_SOURCE_DIR}/Benchmarks/CorpusGenerator.cpp)
+  target_compile_definitions(
+    FastPathCheck
+    PRIVATE CPPPROJECT_EXECUTABLE="$<TARGET_FILE:CPPProject>"
+            CPPPROJECT_SOURCE_DIR="${PROJECT_SOURCE_DIR}")
+  add_dependencies(FastPathCheck CPPProject)
+  set_target_properties(FastPathCheck PROPERTIES LINKER_LANGUAGE "CXX")
+  add_test(NAME FastPathCheck COMMAND FastPathCheck)
+
+  # Saturating SafeType arithmetic against the if/else-if chains it replaced.
+  add_executable(
+    SafeTypeArithmeticBenchmark
+    ${PROJECT_SOURCE_DIR}/Benchmarks/SafeTypeArithmeticBenchmark.cpp)
+  set_target_properties(SafeTypeArithmeticBenchmark PROPERTIES LINKER_LANGUAGE "CXX")
+  # The check of the results alone, without timings, runs as a test.
+  add_test(NAME SafeTypeArithmeticCheck COMMAND SafeTypeArithmeticBenchmark --check)
+
+  # Clamping spans of floats into SafeType bounds, checked against one SafeType
+  # per value.
+  add_executable(
+    SafeTypeBulkBenchmark ${PROJECT_SOURCE_DIR}/Benchmarks/SafeTypeBulkBenchmark.cpp)
+  set_target_properties(SafeTypeBulkBenchmark PROPERTIES LINKER_LANGUAGE "CXX")
+  add_test(NAME SafeTypeBulkCheck COMMAND SafeTypeBulkBenchmark --check)
+
+endfunction(buildBenchmarks)
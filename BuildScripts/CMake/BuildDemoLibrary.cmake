@@ -8,8 +8,19 @@ function(buildCPPProject)
   file(
     GLOB_RECURSE
     CPPProject_SOURCES
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BatchMode.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Cursor.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/CursorLog.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/Instrumentation.cpp
     ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/ParseHeader.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/ResultCache.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/ResultSink.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/SharedPreamble.cpp
     ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StateMachine.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StringPool.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/TokenScanner.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/WatchMode.cpp
     # ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstDumpOrig.cpp
   )
   message("CPPProject Sources: " ${CPPProject_SOURCES})
@@ -22,7 +33,37 @@ function(buildCPPProject)
   include_directories(${PROJECT_SOURCE_DIR}/CoreFunctions)
   link_directories("/usr/lib/llvm-11/lib/")
   add_executable(CPPProject "${CPPProject_SOURCES}")
-  target_link_libraries(CPPProject clang)
+  find_package(Threads REQUIRED)
+  target_link_libraries(CPPProject clang Threads::Threads)
   set_target_properties(CPPProject PROPERTIES LINKER_LANGUAGE "CXX")
 
+  # Debugging aid: dumps the AST of a header as seen by libclang.
+  add_executable(
+    AstDump ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstDump.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstFilter.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstMerkle.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstSnapshot.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp)
+  target_link_libraries(AstDump clang)
+  set_target_properties(AstDump PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # Queries over the snapshots written by AstDump --snapshot.
+  add_executable(
+    QueryAstSnapshot
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/QueryAstSnapshot.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstSnapshot.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp
+    ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StringPool.cpp)
+  target_link_libraries(QueryAstSnapshot clang)
+  set_target_properties(QueryAstSnapshot PROPERTIES LINKER_LANGUAGE "CXX")
+
+  # Structural diff of two versions of a header.
+  add_executable(
+    AstDiff ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstDiff.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/AstMerkle.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/BufferedWriter.cpp
+            ${PROJECT_SOURCE_DIR}/CoreFunctions/Application/StringPool.cpp)
+  target_link_libraries(AstDiff clang)
+  set_target_properties(AstDiff PROPERTIES LINKER_LANGUAGE "CXX")
+
 endfunction(buildCPPProject)
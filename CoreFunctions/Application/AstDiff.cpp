@@ -0,0 +1,143 @@
+/**
+ * @file AstDiff.cpp
+ * @brief Reports the subtrees of the AST telling two versions of a header apart, e.g., whether the
+ * interface of a component changed, and where.
+ * @details Both headers are parsed as AstDump parses them, and hashed per subtree (see
+ * AstMerkle.hpp). Subtrees hashing alike are not looked into. One line per change:
+ *   - <kind> <path> <type> line:<line>:<column>        a subtree found in before only
+ *   + <kind> <path> <type> line:<line>:<column>        a subtree found in after only
+ *   ~ <kind> <path> <type> -> <type> line:<line>:<column>  a subtree changed in place
+ * Locations are those in after, except for removed subtrees.
+ *
+ * Usage: AstDiff <before> <after>
+ *
+ * As diff does, exits with 0 if the headers are structurally equal, 1 if not, and 2 on trouble.
+ */
+
+#include "AstMerkle.hpp"
+#include "BufferedWriter.hpp"
+#include <clang-c/Index.h>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace
+{
+  using RomanoViolet::MerkleChange;
+  using RomanoViolet::MerkleNode;
+  using RomanoViolet::MerkleTree;
+  using RomanoViolet::StringRef;
+
+  constexpr int exitEqual = 0;
+  constexpr int exitDifferent = 1;
+  constexpr int exitTrouble = 2;
+
+  // Parses header with the flags and arguments of AstDump, nullptr if it cannot be parsed.
+  CXTranslationUnit parseHeader( CXIndex index, const std::string &header )
+  {
+    unsigned flags = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
+                     | CXTranslationUnit_Flags::CXTranslationUnit_IgnoreNonErrorsFromIncludedFiles
+                     | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete
+                     | CXTranslationUnit_Flags::CXTranslationUnit_DetailedPreprocessingRecord;
+
+    constexpr const char *defaultArguments[]
+        = { "-x", "c++", "-std=c++11", "-Xclang", "-I/workspaces/LLVM/CoreFunctions" };
+
+    return clang_parseTranslationUnit( index,
+                                       /*source_filename=*/header.c_str( ),
+                                       /*command_line_args=*/defaultArguments,
+                                       /*num_command_line_args=*/5,
+                                       /*unsaved_files=*/nullptr,
+                                       /*num_unsaved_files=*/0,
+                                       /*options=*/flags );
+  }
+
+  bool buildTree( CXIndex index, const std::string &header, MerkleTree &tree )
+  {
+    CXTranslationUnit tu = parseHeader( index, header );
+    if ( tu == nullptr ) {
+      std::cerr << "Unable to parse translation unit: " << header << "\n";
+      return false;
+    }
+    tree.Build( tu );
+    clang_disposeTranslationUnit( tu );
+    return true;
+  }
+
+  void writeNode( RomanoViolet::BufferedWriter &out,
+                  const MerkleTree &tree,
+                  std::uint32_t index )
+  {
+    const MerkleNode &node = tree.GetNode( index );
+    const CXString kind = clang_getCursorKindSpelling( node._kind );
+    out.Write( clang_getCString( kind ) );
+    clang_disposeString( kind );
+    out.Put( ' ' );
+    out.Write( StringRef( tree.GetPath( index ) ) );
+    out.Put( ' ' );
+    out.Write( StringRef( node._typeSpelling ) );
+  }
+
+  void writeLocation( RomanoViolet::BufferedWriter &out, const MerkleNode &node )
+  {
+    out.Write( " line:" );
+    out.WriteInteger( node._line );
+    out.Put( ':' );
+    out.WriteInteger( node._column );
+    out.Put( '\n' );
+  }
+
+  void writeChange( RomanoViolet::BufferedWriter &out,
+                    const MerkleTree &before,
+                    const MerkleTree &after,
+                    const MerkleChange &change )
+  {
+    switch ( change._kind ) {
+      case MerkleChange::Kind::removed:
+        out.Write( "- " );
+        writeNode( out, before, change._before );
+        writeLocation( out, before.GetNode( change._before ) );
+        break;
+      case MerkleChange::Kind::added:
+        out.Write( "+ " );
+        writeNode( out, after, change._after );
+        writeLocation( out, after.GetNode( change._after ) );
+        break;
+      case MerkleChange::Kind::changed:
+        out.Write( "~ " );
+        writeNode( out, before, change._before );
+        out.Write( " -> " );
+        out.Write( StringRef( after.GetNode( change._after )._typeSpelling ) );
+        writeLocation( out, after.GetNode( change._after ) );
+        break;
+    }
+  }  // writeChange
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  if ( ( argc != 3 ) || ( std::string( argv[1] ).compare( 0, 2, "--" ) == 0 )
+       || ( std::string( argv[2] ).compare( 0, 2, "--" ) == 0 ) ) {
+    std::cerr << "Usage: " << argv[0] << " <before> <after>\n";
+    return exitTrouble;
+  }
+
+  CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                     /*displayDiagnostics=*/true );
+  MerkleTree before;
+  MerkleTree after;
+  const bool isParsed = buildTree( index, argv[1], before ) && buildTree( index, argv[2], after );
+  clang_disposeIndex( index );
+  if ( !isParsed ) {
+    return exitTrouble;
+  }
+
+  std::vector< MerkleChange > changes;
+  RomanoViolet::DiffMerkleTrees( before, after, changes );
+
+  RomanoViolet::BufferedWriter out( std::cout );
+  for ( const MerkleChange &change : changes ) {
+    writeChange( out, before, after, change );
+  }
+  return changes.empty( ) ? exitEqual : exitDifferent;
+}
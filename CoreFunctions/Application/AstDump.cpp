@@ -1,17 +1,74 @@
 #include <clang-c/Index.h>
 
+#include "AstFilter.hpp"
+#include "AstMerkle.hpp"
+#include "AstSnapshot.hpp"
+#include "BufferedWriter.hpp"
+#include <cstdint>
 #include <cstdlib>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <utility>
+#include <vector>
 
 using LineColumn = std::pair< unsigned, unsigned >;
-
-struct Data {
-  unsigned childOffset;
-  std::string oldPrefix;
+using RomanoViolet::AstFilter;
+using RomanoViolet::MerkleTree;
+using RomanoViolet::AstSnapshotNode;
+using RomanoViolet::AstSnapshotWriter;
+using RomanoViolet::BufferedWriter;
+
+// Command line options understood by the dumper.
+struct Options {
+  // Dump the tree alone, without the debug information reported per cursor, see
+  // printDebugInformation( ).
+  bool quiet = false;
+  // File the dump is written to. Empty for std::cout.
+  std::string outputFile;
+  // File a binary snapshot of the tree is written to instead of the text dump, see
+  // AstSnapshot.hpp. Empty if not requested.
+  std::string snapshotFile;
+  // The cursors dumped, and the subtrees skipped, see AstFilter.hpp. With a snapshot, only the
+  // subtrees skipped.
+  AstFilter filter;
+  // List the structural hash of every subtree instead of the dump, see AstMerkle.hpp.
+  bool merkle = false;
+  std::string header;
 };
 
+bool parseOptions( int argc, const char *argv[], Options &options )
+{
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( argument.compare( "--quiet" ) == 0 ) {
+      options.quiet = true;
+    } else if ( ( argument.compare( "--output" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.outputFile = argv[++i];
+    } else if ( ( argument.compare( "--snapshot" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.snapshotFile = argv[++i];
+    } else if ( ( argument.compare( "--filter" ) == 0 ) && ( i + 1 < argc ) ) {
+      std::string error;
+      if ( !options.filter.Parse( argv[++i], error ) ) {
+        std::cerr << "Invalid filter: " << error << "\n";
+        return false;
+      }
+    } else if ( argument.compare( "--merkle" ) == 0 ) {
+      options.merkle = true;
+    } else if ( ( argument.compare( 0, 2, "--" ) != 0 ) && options.header.empty( ) ) {
+      options.header = argument;
+    } else {
+      std::cerr << "Unknown argument: " << argument << "\n";
+      return false;
+    }
+  }
+  if ( options.merkle && ( !options.snapshotFile.empty( ) || !options.filter.IsEmpty( ) ) ) {
+    std::cerr << "--merkle lists every subtree, and takes neither --snapshot nor --filter.\n";
+    return false;
+  }
+  return !options.header.empty( );
+}
+
 std::string toString( CXString cxString )
 {
   std::string string = clang_getCString( cxString );
@@ -19,6 +76,13 @@ std::string toString( CXString cxString )
   return string;
 }
 
+// Writes cxString, without copying it into a std::string first.
+void write( BufferedWriter &out, CXString cxString )
+{
+  out.Write( clang_getCString( cxString ) );
+  clang_disposeString( cxString );
+}
+
 LineColumn toLineColumn( CXSourceLocation location )
 {
   CXFile file;
@@ -27,40 +91,107 @@ LineColumn toLineColumn( CXSourceLocation location )
   return { line, column };
 }
 
-void printRelativeLocation( LineColumn previous, LineColumn location )
+void printRelativeLocation( BufferedWriter &out, LineColumn previous, LineColumn location )
 {
   if ( location.first == previous.first ) {
-    std::cout << "col:" << location.second;
+    out.Write( "col:" );
+    out.WriteInteger( location.second );
   } else {
-    std::cout << "line:" << location.first << ":" << location.second;
+    out.Write( "line:" );
+    out.WriteInteger( location.first );
+    out.Put( ':' );
+    out.WriteInteger( location.second );
   }
 }
 
-CXChildVisitResult countChildren( CXCursor cursor, CXCursor parent, CXClientData data )
+// A cursor waiting to be dumped. Cursors are dumped depth first, in the order of
+// clang_visitChildren, from an explicit stack instead of by recursion, so that deep ASTs do not
+// exhaust the call stack.
+struct Frame {
+  CXCursor cursor;
+  CXCursor parent;
+  // the snapshot node of parent, if a snapshot is taken.
+  std::uint32_t parentNode;
+  // 0 for the children of the translation unit.
+  unsigned depth;
+  // whether no dumped sibling follows, which selects "`-" over "|-".
+  bool isLast;
+  // whether an ancestor is enclosing, see AstFilter::IsEnclosing.
+  bool isUnder;
+  // cursors in system headers are reported, but neither dumped nor descended into.
+  bool isInSystemHeader;
+};
+
+// The children of a cursor being collected.
+struct Collection {
+  std::vector< Frame > &children;
+  const AstFilter &filter;
+  unsigned depth;
+};
+
+CXChildVisitResult collectChildren( CXCursor cursor, CXCursor parent, CXClientData data )
 {
-  auto *count = reinterpret_cast< unsigned * >( data );
-  *count += 1;
+  auto *collection = reinterpret_cast< Collection * >( data );
+  const bool isInSystemHeader
+      = clang_Location_isInSystemHeader( clang_getCursorLocation( cursor ) ) != 0;
+  // with a filter, pruned subtrees are not even reported: they are never entered.
+  if ( !collection->filter.IsEmpty( )
+       && ( isInSystemHeader || !collection->filter.IsWorthVisiting( cursor, collection->depth ) ) ) {
+    return CXChildVisit_Continue;
+  }
+  collection->children.push_back(
+      Frame{ cursor, parent, AstSnapshotNode::none, 0, false, false, isInSystemHeader } );
   return CXChildVisit_Continue;
 }
 
-CXChildVisitResult visit( CXCursor cursor, CXCursor parent, CXClientData clientData )
+// Pushes the children of parent onto stack, such that the first child is popped first. The list
+// of children is walked once; children is scratch space.
+void pushChildren( CXCursor parent,
+                   std::uint32_t parentNode,
+                   unsigned depth,
+                   bool isUnder,
+                   const AstFilter &filter,
+                   std::vector< Frame > &children,
+                   std::vector< Frame > &stack )
+{
+  children.clear( );
+  Collection collection{ children, filter, depth };
+  clang_visitChildren( parent, collectChildren, &collection );
+
+  bool isLastFound = false;
+  for ( auto child = children.rbegin( ); child != children.rend( ); ++child ) {
+    child->parentNode = parentNode;
+    child->depth = depth;
+    child->isUnder = isUnder;
+    if ( !isLastFound && !child->isInSystemHeader ) {
+      child->isLast = true;
+      isLastFound = true;
+    }
+    stack.push_back( *child );
+  }
+}  // pushChildren
+
+// Everything reported about a cursor, system header or not, before it is dumped.
+void printDebugInformation( BufferedWriter &out, CXCursor cursor, CXCursor parent )
 {
   if ( cursor.kind == CXCursorKind ::CXCursor_MacroDefinition ) {
-    std::cout << "Macro" << std::endl;
+    out.Write( "Macro\n" );
   }
 
   if ( cursor.kind == CXCursorKind ::CXCursor_ClassDecl ) {
-    std::cout << "Class" << std::endl;
+    out.Write( "Class\n" );
   }
 
   if ( cursor.kind == CXCursorKind ::CXCursor_CXXBaseSpecifier ) {
-    std::cout << "Base" << std::endl;
-    std::cout << toString( clang_getCursorSpelling( cursor ) ) << std::endl;
+    out.Write( "Base\n" );
+    write( out, clang_getCursorSpelling( cursor ) );
+    out.Put( '\n' );
   }
 
   if ( cursor.kind == CXCursorKind::CXCursor_FieldDecl ) {
-    std::cout << "Declaration" << std::endl;
-    std::cout << toString( clang_getTypeSpelling( clang_getCursorType( cursor ) ) ) << std::endl;
+    out.Write( "Declaration\n" );
+    write( out, clang_getTypeSpelling( clang_getCursorType( cursor ) ) );
+    out.Put( '\n' );
     // std::cout << toString(
     //     clang_getCursorSpelling( clang_getTypeDeclaration( clang_getCursorType( cursor ) ) ) )
     //           << std::endl;
@@ -72,63 +203,93 @@ CXChildVisitResult visit( CXCursor cursor, CXCursor parent, CXClientData clientD
            clang_getCursorSpelling( clang_getTypeDeclaration( clang_getCursorType( cursor ) ) ) )
            .compare( "TypeInputInterface" )
        == 0 ) {
-    std::cout << toString( clang_getTypeSpelling( clang_getCursorType( cursor ) ) ) << std::endl;
-    std::cout << "Found an input interface" << std::endl;
+    write( out, clang_getTypeSpelling( clang_getCursorType( cursor ) ) );
+    out.Write( "\nFound an input interface\n" );
   }
 
-  std::cout << "nArgs: " << clang_Type_getNumTemplateArguments( clang_getCursorType( cursor ) )
-            << std::endl;
+  out.Write( "nArgs: " );
+  out.WriteInteger( clang_Type_getNumTemplateArguments( clang_getCursorType( cursor ) ) );
+  out.Put( '\n' );
 
   if ( clang_Type_getNumTemplateArguments( clang_getCursorType( cursor ) ) == 1 ) {
     // std::cout << toString( clang_getTypeSpelling(
     //     clang_Type_getNamedType( clang_Cursor_getTemplateArgumentType( cursor, 0 ) ) ) )
     //           << std::endl;
 
-    std::cout << toString( clang_getCursorSpelling( cursor ) ) << std::endl;
+    write( out, clang_getCursorSpelling( cursor ) );
+    out.Put( '\n' );
 
     const CXType type = clang_getCursorType( cursor );
-    std::cout << toString( clang_getTypeSpelling( type ) ) << std::endl;
-    std::cout << toString( clang_getCursorSpelling( clang_getTypeDeclaration( type ) ) )
-              << std::endl;
+    write( out, clang_getTypeSpelling( type ) );
+    out.Put( '\n' );
+    write( out, clang_getCursorSpelling( clang_getTypeDeclaration( type ) ) );
+    out.Put( '\n' );
   }
 
   if ( ( cursor.kind == CXCursorKind ::CXCursor_TemplateRef )
        && ( parent.kind == CXCursorKind::CXCursor_FieldDecl ) ) {
-    std::cout << "Something ..." << std::endl;
-    std::cout << toString( clang_getCursorSpelling( cursor ) ) << std::endl;
+    out.Write( "Something ...\n" );
+    write( out, clang_getCursorSpelling( cursor ) );
+    out.Put( '\n' );
     const CXType type = clang_getCursorType( cursor );
-    std::cout << toString( clang_getTypeSpelling( type ) ) << std::endl;
-    std::cout << toString( clang_getCursorSpelling( clang_getTypeDeclaration( type ) ) )
-              << std::endl;
+    write( out, clang_getTypeSpelling( type ) );
+    out.Put( '\n' );
+    write( out, clang_getCursorSpelling( clang_getTypeDeclaration( type ) ) );
+    out.Put( '\n' );
   }
 
   if ( toString(
            clang_getCursorSpelling( clang_getTypeDeclaration( clang_getCursorType( cursor ) ) ) )
            .compare( "TypeOutputInterface" )
        == 0 ) {
-    std::cout << "Found an output interface" << std::endl;
+    out.Write( "Found an output interface\n" );
   }
+}  // printDebugInformation
 
-  CXSourceLocation location = clang_getCursorLocation( cursor );
-  if ( clang_Location_isInSystemHeader( location ) ) {
-    return CXChildVisit_Continue;
+// Reported after the line of a class declared in a namespace.
+void printClassDeclaration( BufferedWriter &out, CXCursor cursor, CXCursor parent )
+{
+  // if ( ( parent.kind == CXCursorKind ::CXCursor_TranslationUnit )
+  //      && ( cursor.kind == CXCursorKind ::CXCursor_ClassDecl ) ) {
+  if ( ( cursor.kind != CXCursorKind ::CXCursor_ClassDecl )
+       || ( parent.kind != CXCursorKind::CXCursor_Namespace ) ) {
+    return;
   }
 
-  auto *data = reinterpret_cast< Data * >( clientData );
-  std::cout << data->oldPrefix;
+  // a new type of node.
+  const CXCursor definition = clang_getCursorDefinition( cursor );
+  out.Write( "Class Declaration\n" );
+  out.WriteInteger( clang_hashCursor( definition ) );
+  out.Put( '\n' );
+  write( out, clang_getCursorKindSpelling( clang_getCursorKind( cursor ) ) );
+  out.Put( '\n' );
+  out.WriteInteger( clang_hashCursor( cursor ) );
+  out.Put( '\n' );
 
-  std::string prefix = data->oldPrefix;
-  if ( data->childOffset == 1 ) {
-    std::cout << "`-";
-    prefix += "  ";
-  } else {
-    std::cout << "|-";
-    prefix += "| ";
+  if ( !clang_Cursor_isNull( definition ) && !clang_equalCursors( cursor, definition ) ) {
+    out.WriteInteger( clang_hashCursor( definition ) );
+    out.Put( '\n' );
   }
 
+  out.Write( "Namespace: " );
+  write( out, clang_getCursorSpelling( parent ) );
+  out.Write( "\nClass Name: " );
+  write( out, clang_getCursorSpelling( cursor ) );
+  out.Put( '\n' );
+
+  write( out, clang_getTypeSpelling( clang_getCursorType( cursor ) ) );
+  out.Write( "\n\n" );
+}  // printClassDeclaration
+
+// Dumps the line of a cursor, following the tree-drawing prefix already written.
+void printCursor( BufferedWriter &out, CXCursor cursor, CXCursor parent )
+{
+  const CXSourceLocation location = clang_getCursorLocation( cursor );
   const CXCursorKind kind = clang_getCursorKind( cursor );
-  std::cout << toString( clang_getCursorKindSpelling( kind ) ) << " ";
-  std::cout << clang_hashCursor( cursor ) << " ";
+  write( out, clang_getCursorKindSpelling( kind ) );
+  out.Put( ' ' );
+  out.WriteInteger( clang_hashCursor( cursor ) );
+  out.Put( ' ' );
 
   const CXSourceRange range = clang_getCursorExtent( cursor );
   auto parentLocation = toLineColumn( clang_getCursorLocation( parent ) );
@@ -136,78 +297,150 @@ CXChildVisitResult visit( CXCursor cursor, CXCursor parent, CXClientData clientD
   auto end = toLineColumn( clang_getRangeEnd( range ) );
   end.second -= 1;
 
-  std::cout << "<";
-  printRelativeLocation( parentLocation, start );
+  out.Put( '<' );
+  printRelativeLocation( out, parentLocation, start );
   if ( start != end ) {
-    std::cout << ", ";
-    printRelativeLocation( start, end );
+    out.Write( ", " );
+    printRelativeLocation( out, start, end );
   }
-  std::cout << "> ";
-  printRelativeLocation( end, toLineColumn( location ) );
-  std::cout << " ";
+  out.Write( "> " );
+  printRelativeLocation( out, end, toLineColumn( location ) );
+  out.Put( ' ' );
 
   const CXCursor definition = clang_getCursorDefinition( cursor );
   if ( !clang_Cursor_isNull( definition ) && !clang_equalCursors( cursor, definition ) ) {
-    std::cout << clang_hashCursor( definition ) << " ";
+    out.WriteInteger( clang_hashCursor( definition ) );
+    out.Put( ' ' );
   }
 
-  std::cout << toString( clang_getCursorSpelling( cursor ) ) << " ";
+  write( out, clang_getCursorSpelling( cursor ) );
+  out.Put( ' ' );
 
   const CXType type = clang_getCursorType( cursor );
-  std::cout << toString( clang_getTypeSpelling( type ) ) << " ";
+  write( out, clang_getTypeSpelling( type ) );
+  out.Write( " \n" );
+}  // printCursor
+
+// Dumps the tree as text into out, or, if snapshot is not nullptr, adds it to snapshot instead.
+// With a filter, the cursors matching it are dumped, indented by depth, but without the lines of
+// the tree: their parents are not necessarily dumped.
+void traverse( BufferedWriter &out,
+               CXTranslationUnit tu,
+               const Options &options,
+               AstSnapshotWriter *snapshot )
+{
+  CXCursor root = clang_getTranslationUnitCursor( tu );
 
-  std::cout << std::endl;
+  std::uint32_t rootNode = AstSnapshotNode::none;
+  if ( snapshot != nullptr ) {
+    rootNode = snapshot->Add( root, AstSnapshotNode::none );
+  } else {
+    CXCursorKind kind = clang_getCursorKind( root );
+    write( out, clang_getCursorKindSpelling( kind ) );
+    out.Put( '\n' );
+  }
 
-  // if ( ( parent.kind == CXCursorKind ::CXCursor_TranslationUnit )
-  //      && ( cursor.kind == CXCursorKind ::CXCursor_ClassDecl ) ) {
-  if ( ( cursor.kind == CXCursorKind ::CXCursor_ClassDecl )
-       && ( parent.kind == CXCursorKind::CXCursor_Namespace ) ) {
-    // a new type of node.
-    std::cout << "Class Declaration" << std::endl;
-    std::cout << clang_hashCursor( definition ) << std::endl;
-    const CXCursorKind kind = clang_getCursorKind( cursor );
-    std::cout << toString( clang_getCursorKindSpelling( kind ) ) << std::endl;
-    std::cout << clang_hashCursor( cursor ) << std::endl;
-    const CXCursor definition = clang_getCursorDefinition( cursor );
-
-    if ( !clang_Cursor_isNull( definition ) && !clang_equalCursors( cursor, definition ) ) {
-      std::cout << clang_hashCursor( definition ) << std::endl;
+  std::vector< Frame > stack;
+  std::vector< Frame > children;
+  const AstFilter &filter = options.filter;
+  pushChildren( root, rootNode, 0, false, filter, children, stack );
+
+  // Popping a cursor at depth d leaves the prefix of its ancestors in the first 2 * d characters:
+  // the cursor dumped last is the parent of the cursor, or a descendant of one of its ancestors.
+  std::string prefix;
+  while ( !stack.empty( ) ) {
+    const Frame frame = stack.back( );
+    stack.pop_back( );
+
+    const bool isMatching
+        = filter.IsEmpty( ) || filter.Matches( frame.cursor, frame.depth, frame.isUnder );
+    if ( !options.quiet && ( snapshot == nullptr ) && isMatching ) {
+      printDebugInformation( out, frame.cursor, frame.parent );
+    }
+    if ( frame.isInSystemHeader ) {
+      continue;
     }
 
-    std::cout << "Namespace: " << toString( clang_getCursorSpelling( parent ) ) << std::endl;
-    std::cout << "Class Name: " << toString( clang_getCursorSpelling( cursor ) ) << std::endl;
+    std::uint32_t node = AstSnapshotNode::none;
+    if ( snapshot != nullptr ) {
+      node = snapshot->Add( frame.cursor, frame.parentNode );
+    } else if ( !filter.IsEmpty( ) ) {
+      if ( isMatching ) {
+        prefix.assign( 2 * frame.depth, ' ' );
+        out.Write( prefix.data( ), prefix.size( ) );
+        printCursor( out, frame.cursor, frame.parent );
+        if ( !options.quiet ) {
+          printClassDeclaration( out, frame.cursor, frame.parent );
+        }
+      }
+    } else {
+      prefix.resize( 2 * frame.depth );
+      out.Write( prefix.data( ), prefix.size( ) );
+      out.Write( frame.isLast ? "`-" : "|-" );
+      printCursor( out, frame.cursor, frame.parent );
+      if ( !options.quiet ) {
+        printClassDeclaration( out, frame.cursor, frame.parent );
+      }
+      prefix.append( frame.isLast ? "  " : "| " );
+    }
 
-    const CXType type = clang_getCursorType( cursor );
-    std::cout << toString( clang_getTypeSpelling( type ) ) << std::endl;
-    std::cout << std::endl;
+    pushChildren( frame.cursor,
+                  node,
+                  frame.depth + 1,
+                  frame.isUnder || filter.IsEnclosing( frame.cursor ),
+                  filter,
+                  children,
+                  stack );
   }
+}  // traverse
 
-  unsigned numberOfChildren = 0;
-  clang_visitChildren( cursor, countChildren, &numberOfChildren );
-
-  Data nextData{ numberOfChildren, prefix };
-  clang_visitChildren( cursor, visit, &nextData );
-
-  data->childOffset -= 1;
-  return CXChildVisit_Continue;
-}
-
-void traverse( CXTranslationUnit tu )
+// Lists the nodes of tree one per line, in the order of the dump: the hash of the subtree, then the
+// kind and spelling of the node, indented by depth. The first line hashes the whole header.
+void writeMerkleTree( BufferedWriter &out, const MerkleTree &tree )
 {
-  CXCursor root = clang_getTranslationUnitCursor( tu );
-
-  CXCursorKind kind = clang_getCursorKind( root );
-  std::cout << toString( clang_getCursorKindSpelling( kind ) ) << '\n';
-
-  unsigned numberOfChildren = 0;
-  clang_visitChildren( root, countChildren, &numberOfChildren );
+  std::vector< std::pair< std::uint32_t, unsigned > > stack{ { 0, 0 } };
+  while ( !stack.empty( ) ) {
+    const std::pair< std::uint32_t, unsigned > entry = stack.back( );
+    stack.pop_back( );
+
+    const RomanoViolet::MerkleNode &node = tree.GetNode( entry.first );
+    out.WriteHexadecimal( node._hash );
+    out.Put( ' ' );
+    for ( unsigned i = 0; i < entry.second; ++i ) {
+      out.Write( "  " );
+    }
+    write( out, clang_getCursorKindSpelling( node._kind ) );
+    if ( !node._spelling.empty( ) ) {
+      out.Put( ' ' );
+      out.Write( RomanoViolet::StringRef( node._spelling ) );
+    }
+    out.Put( '\n' );
 
-  Data data{ numberOfChildren, "" };
-  clang_visitChildren( root, visit, &data );
-}
+    for ( auto child = node._children.rbegin( ); child != node._children.rend( ); ++child ) {
+      stack.emplace_back( *child, entry.second + 1 );
+    }
+  }
+}  // writeMerkleTree
 
 auto main( int argc, const char *argv[] ) -> int
 {
+  Options options;
+  if ( !parseOptions( argc, argv, options ) ) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--quiet] [--output <file>] [--snapshot <file>] [--filter <expression>]"
+                 " [--merkle] <header>\n";
+    return EXIT_FAILURE;
+  }
+
+  std::ofstream file;
+  if ( !options.outputFile.empty( ) ) {
+    file.open( options.outputFile, std::ios::binary | std::ios::trunc );
+    if ( !file.is_open( ) ) {
+      std::cerr << "Unable to open output file: " << options.outputFile << "\n";
+      return EXIT_FAILURE;
+    }
+  }
+
   CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
                                      /*displayDiagnostics=*/true );
 
@@ -223,19 +456,41 @@ auto main( int argc, const char *argv[] ) -> int
       = { "-x", "c++", "-std=c++11", "-Xclang", "-I/workspaces/LLVM/CoreFunctions" };
 
   CXTranslationUnit tu = clang_parseTranslationUnit( index,
-                                                     /*source_filename=*/argv[1],
+                                                     /*source_filename=*/options.header.c_str( ),
                                                      /*command_line_args=*/defaultArguments,
                                                      /*num_command_line_args=*/5,
                                                      /*unsaved_files=*/nullptr,
                                                      /*num_unsaved_files=*/0,
                                                      /*options=*/flags );
 
+  bool isSuccessful = true;
   if ( tu == nullptr ) {
     std::cerr << "Unable to parse translation unit. Quitting.\n";
+    isSuccessful = false;
   } else {
-    traverse( tu );
+    // Dumps run to millions of lines: the output is handed over in chunks of 1 MiB, and never
+    // flushed line by line.
+    std::ostream &out = options.outputFile.empty( ) ? std::cout : file;
+    BufferedWriter writer( out, 1024 * 1024 );
+    if ( options.merkle ) {
+      MerkleTree tree;
+      tree.Build( tu );
+      writeMerkleTree( writer, tree );
+    } else if ( options.snapshotFile.empty( ) ) {
+      traverse( writer, tu, options, nullptr );
+    } else {
+      AstSnapshotWriter snapshot;
+      traverse( writer, tu, options, &snapshot );
+      if ( !snapshot.Write( options.snapshotFile ) ) {
+        std::cerr << "Unable to write snapshot: " << options.snapshotFile << "\n";
+        isSuccessful = false;
+      }
+    }
+    writer.Flush( );
+    out.flush( );
     clang_disposeTranslationUnit( tu );
   }
 
   clang_disposeIndex( index );
+  return isSuccessful ? EXIT_SUCCESS : EXIT_FAILURE;
 }
@@ -0,0 +1,180 @@
+#include "AstFilter.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <fnmatch.h>
+namespace RomanoViolet
+{
+  namespace
+  {
+    std::string toString( CXString cxString )
+    {
+      const char *data = clang_getCString( cxString );
+      std::string string( ( data != nullptr ) ? data : "" );
+      clang_disposeString( cxString );
+      return string;
+    }
+
+    bool isMatching( const std::string &pattern, const std::string &string )
+    {
+      return fnmatch( pattern.c_str( ), string.c_str( ), 0 ) == 0;
+    }
+
+    // Reads the number of a depth term, e.g., "3". false if it is not one.
+    bool readDepth( const std::string &text, unsigned &depth )
+    {
+      if ( text.empty( ) || ( text.find_first_not_of( "0123456789" ) != std::string::npos ) ) {
+        return false;
+      }
+      depth = static_cast< unsigned >( std::strtoul( text.c_str( ), nullptr, 10 ) );
+      return true;
+    }
+  }  // namespace
+
+  AstFilter::AstFilter( )
+      : _isEmpty( true )
+      , _kinds( )
+      , _spelling( )
+      , _file( )
+      , _under( )
+      , _minimumDepth( 0 )
+      , _maximumDepth( static_cast< unsigned >( -1 ) )
+      , _isDepthEmpty( false )
+      , _isKindMatching( )
+      , _lastFile( nullptr )
+      , _isLastFileMatching( false )
+  {
+  }
+
+  bool AstFilter::Parse( const std::string &expression, std::string &error )
+  {
+    *this = AstFilter( );
+
+    std::size_t begin = 0;
+    while ( begin <= expression.size( ) ) {
+      std::size_t end = expression.find( ',', begin );
+      if ( end == std::string::npos ) {
+        end = expression.size( );
+      }
+      const std::string term = expression.substr( begin, end - begin );
+      begin = end + 1;
+      if ( term.empty( ) ) {
+        continue;
+      }
+      this->_isEmpty = false;
+
+      if ( term.compare( 0, 5, "depth" ) == 0 ) {
+        const std::size_t valueBegin = term.find_first_of( "0123456789" );
+        const std::string op = term.substr( 5, valueBegin - 5 );
+        unsigned depth;
+        if ( ( valueBegin == std::string::npos ) || !readDepth( term.substr( valueBegin ), depth ) ) {
+          error = "Expected a depth in: " + term;
+          return false;
+        }
+        if ( op.compare( "=" ) == 0 ) {
+          this->_minimumDepth = std::max( this->_minimumDepth, depth );
+          this->_maximumDepth = std::min( this->_maximumDepth, depth );
+        } else if ( op.compare( "<=" ) == 0 ) {
+          this->_maximumDepth = std::min( this->_maximumDepth, depth );
+        } else if ( op.compare( "<" ) == 0 ) {
+          this->_isDepthEmpty = this->_isDepthEmpty || ( depth == 0 );
+          this->_maximumDepth = std::min( this->_maximumDepth, depth - 1 );
+        } else if ( op.compare( ">=" ) == 0 ) {
+          this->_minimumDepth = std::max( this->_minimumDepth, depth );
+        } else if ( op.compare( ">" ) == 0 ) {
+          this->_minimumDepth = std::max( this->_minimumDepth, depth + 1 );
+        } else {
+          error = "Unknown comparison in: " + term;
+          return false;
+        }
+        this->_isDepthEmpty = this->_isDepthEmpty || ( this->_minimumDepth > this->_maximumDepth );
+        continue;
+      }
+
+      const std::size_t equals = term.find( '=' );
+      if ( equals == std::string::npos ) {
+        error = "Expected <name>=<value> in: " + term;
+        return false;
+      }
+      const std::string name = term.substr( 0, equals );
+      const std::string value = term.substr( equals + 1 );
+      if ( name.compare( "kind" ) == 0 ) {
+        std::size_t kindBegin = 0;
+        while ( kindBegin <= value.size( ) ) {
+          std::size_t kindEnd = value.find( '|', kindBegin );
+          if ( kindEnd == std::string::npos ) {
+            kindEnd = value.size( );
+          }
+          this->_kinds.emplace_back( value.substr( kindBegin, kindEnd - kindBegin ) );
+          kindBegin = kindEnd + 1;
+        }
+      } else if ( name.compare( "spelling" ) == 0 ) {
+        this->_spelling = value;
+      } else if ( name.compare( "file" ) == 0 ) {
+        this->_file = value;
+      } else if ( name.compare( "under" ) == 0 ) {
+        this->_under = value;
+      } else {
+        error = "Unknown term: " + term;
+        return false;
+      }
+    }
+    return true;
+  }  // AstFilter::Parse
+
+  bool AstFilter::IsEmpty( ) const
+  {
+    return this->_isEmpty;
+  }
+
+  bool AstFilter::IsKindMatching( CXCursorKind kind ) const
+  {
+    const auto found = this->_isKindMatching.find( static_cast< int >( kind ) );
+    if ( found != this->_isKindMatching.end( ) ) {
+      return found->second;
+    }
+    const std::string spelling = toString( clang_getCursorKindSpelling( kind ) );
+    bool isMatching = false;
+    for ( const std::string &wanted : this->_kinds ) {
+      isMatching = isMatching || ( wanted.compare( spelling ) == 0 );
+    }
+    this->_isKindMatching.emplace( static_cast< int >( kind ), isMatching );
+    return isMatching;
+  }  // AstFilter::IsKindMatching
+
+  bool AstFilter::IsFileMatching( CXCursor cursor ) const
+  {
+    CXFile file;
+    unsigned line, column, offset;
+    clang_getSpellingLocation( clang_getCursorLocation( cursor ), &file, &line, &column, &offset );
+    if ( ( file != this->_lastFile ) || ( file == nullptr ) ) {
+      this->_lastFile = file;
+      this->_isLastFileMatching
+          = ( file != nullptr ) && isMatching( this->_file, toString( clang_getFileName( file ) ) );
+    }
+    return this->_isLastFileMatching;
+  }  // AstFilter::IsFileMatching
+
+  bool AstFilter::IsWorthVisiting( CXCursor cursor, unsigned depth ) const
+  {
+    if ( this->_isDepthEmpty || ( depth > this->_maximumDepth ) ) {
+      return false;
+    }
+    return this->_file.empty( ) || this->IsFileMatching( cursor );
+  }  // AstFilter::IsWorthVisiting
+
+  bool AstFilter::IsEnclosing( CXCursor cursor ) const
+  {
+    return !this->_under.empty( )
+           && isMatching( this->_under, toString( clang_getCursorSpelling( cursor ) ) );
+  }
+
+  bool AstFilter::Matches( CXCursor cursor, unsigned depth, bool isUnder ) const
+  {
+    // IsWorthVisiting has been asked before, and holds.
+    return ( depth >= this->_minimumDepth )
+           && ( this->_kinds.empty( ) || this->IsKindMatching( clang_getCursorKind( cursor ) ) )
+           && ( this->_under.empty( ) || isUnder )
+           && ( this->_spelling.empty( )
+                || isMatching( this->_spelling, toString( clang_getCursorSpelling( cursor ) ) ) );
+  }  // AstFilter::Matches
+}  // namespace RomanoViolet
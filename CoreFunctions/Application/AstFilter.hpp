@@ -0,0 +1,69 @@
+#ifndef _ASTFILTER_HPP_
+#define _ASTFILTER_HPP_
+
+#include <clang-c/Index.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Selects the cursors AstDump dumps, and the subtrees it need not visit at all.
+   * @details An expression is a list of terms separated by ',', all of which must hold:
+   *   kind=<kind>[|<kind>...]  the spelling of the kind of the cursor, e.g., FieldDecl
+   *   spelling=<pattern>       the spelling of the cursor, e.g., Comp*
+   *   file=<pattern>           the file the cursor is in, e.g., *Component.hpp
+   *   under=<pattern>          the spelling of an enclosing cursor, e.g., Component
+   *   depth<op><n>             op is one of =, <, <=, >, >=; 0 for the children of the
+   *                            translation unit
+   * Patterns are shell wildcards, see fnmatch. Subtrees in other files, or beyond the depth, are
+   * never visited: the children of a cursor are taken to be in the file of the cursor. The other
+   * terms select among the cursors visited.
+   */
+  class AstFilter
+  {
+  public:
+    AstFilter( );
+
+    /**
+     * @brief Parses expression, replacing the terms parsed before.
+     * @return false if expression is malformed, with error telling why.
+     */
+    bool Parse( const std::string &expression, std::string &error );
+
+    // Whether no term was given, in which case everything matches.
+    bool IsEmpty( ) const;
+
+    // Whether the subtree of cursor, at depth, can hold a match.
+    bool IsWorthVisiting( CXCursor cursor, unsigned depth ) const;
+
+    // Whether cursor matches the pattern of the under term.
+    bool IsEnclosing( CXCursor cursor ) const;
+
+    /**
+     * @brief Whether cursor matches every term.
+     * @param isUnder: Whether an ancestor of cursor IsEnclosing.
+     */
+    bool Matches( CXCursor cursor, unsigned depth, bool isUnder ) const;
+
+  private:
+    bool _isEmpty;
+    std::vector< std::string > _kinds;
+    std::string _spelling;
+    std::string _file;
+    std::string _under;
+    unsigned _minimumDepth;
+    // inclusive. A range without any depth, e.g., depth<0, sets _isDepthEmpty instead.
+    unsigned _maximumDepth;
+    bool _isDepthEmpty;
+    // whether a kind matches, by kind: libclang spells each kind once.
+    mutable std::unordered_map< int, bool > _isKindMatching;
+    // the file asked about last, and whether it matched: cursors come in runs of the same file.
+    mutable CXFile _lastFile;
+    mutable bool _isLastFileMatching;
+
+    bool IsKindMatching( CXCursorKind kind ) const;
+    bool IsFileMatching( CXCursor cursor ) const;
+  };  // class AstFilter
+}  // namespace RomanoViolet
+#endif  // !_ASTFILTER_HPP_
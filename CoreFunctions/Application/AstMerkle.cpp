@@ -0,0 +1,215 @@
+#include "AstMerkle.hpp"
+#include <unordered_map>
+#include <utility>
+namespace RomanoViolet
+{
+  namespace
+  {
+    // 64-bit FNV-1a
+    std::uint64_t hashBytes( const void *bytes, std::size_t size, std::uint64_t hash )
+    {
+      const unsigned char *first = static_cast< const unsigned char * >( bytes );
+      for ( std::size_t i = 0; i < size; ++i ) {
+        hash ^= first[i];
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    std::uint64_t hashString( const std::string &string, std::uint64_t hash )
+    {
+      // the terminating null keeps ("ab", "c") apart from ("a", "bc")
+      return hashBytes( string.c_str( ), string.size( ) + 1, hash );
+    }
+
+    std::string toString( CXString cxString )
+    {
+      const char *data = clang_getCString( cxString );
+      std::string string( ( data != nullptr ) ? data : "" );
+      clang_disposeString( cxString );
+      return string;
+    }
+
+    CXChildVisitResult collectChildren( CXCursor cursor, CXCursor /*parent*/, CXClientData data )
+    {
+      if ( clang_Location_isInSystemHeader( clang_getCursorLocation( cursor ) ) == 0 ) {
+        reinterpret_cast< std::vector< CXCursor > * >( data )->push_back( cursor );
+      }
+      return CXChildVisit_Continue;
+    }
+
+    // A cursor waiting to be numbered, and the node of its parent.
+    struct Pending {
+      CXCursor cursor;
+      std::uint32_t parent;
+    };
+
+    // Children are paired by kind and spelling.
+    std::string pairingKey( const MerkleNode &node )
+    {
+      return std::to_string( static_cast< int >( node._kind ) ) + ':' + node._spelling;
+    }
+  }  // namespace
+
+  constexpr std::uint32_t MerkleNode::none;
+
+  MerkleTree::MerkleTree( ) : _nodes( )
+  {
+  }
+
+  void MerkleTree::Build( CXTranslationUnit tu )
+  {
+    this->_nodes.clear( );
+
+    // The nodes are numbered depth first, from an explicit stack, as AstDump dumps them.
+    std::vector< Pending > stack{ Pending{ clang_getTranslationUnitCursor( tu ), MerkleNode::none } };
+    std::vector< CXCursor > children;
+    while ( !stack.empty( ) ) {
+      const Pending pending = stack.back( );
+      stack.pop_back( );
+
+      MerkleNode node;
+      node._kind = clang_getCursorKind( pending.cursor );
+      // the translation unit is spelled as the path of the header, which is not part of its
+      // structure: two versions of a header in two directories would never compare equal.
+      if ( node._kind != CXCursor_TranslationUnit ) {
+        node._spelling = toString( clang_getCursorSpelling( pending.cursor ) );
+      }
+      node._typeSpelling = toString( clang_getTypeSpelling( clang_getCursorType( pending.cursor ) ) );
+      clang_getSpellingLocation( clang_getCursorLocation( pending.cursor ),
+                                 nullptr,
+                                 &node._line,
+                                 &node._column,
+                                 nullptr );
+      node._hash = 0;
+      node._parent = pending.parent;
+
+      const std::uint32_t index = static_cast< std::uint32_t >( this->_nodes.size( ) );
+      if ( pending.parent != MerkleNode::none ) {
+        this->_nodes[pending.parent]._children.push_back( index );
+      }
+      this->_nodes.push_back( std::move( node ) );
+
+      children.clear( );
+      clang_visitChildren( pending.cursor, collectChildren, &children );
+      for ( auto child = children.rbegin( ); child != children.rend( ); ++child ) {
+        stack.push_back( Pending{ *child, index } );
+      }
+    }
+
+    // Children are numbered after their parent: hashing backwards finds their hashes done.
+    for ( std::size_t i = this->_nodes.size( ); i > 0; --i ) {
+      MerkleNode &node = this->_nodes[i - 1];
+      const std::int32_t kind = static_cast< std::int32_t >( node._kind );
+      std::uint64_t hash = hashBytes( &kind, sizeof( kind ), 14695981039346656037ULL );
+      hash = hashString( node._spelling, hash );
+      hash = hashString( node._typeSpelling, hash );
+      for ( const std::uint32_t child : node._children ) {
+        hash = hashBytes( &this->_nodes[child]._hash, sizeof( std::uint64_t ), hash );
+      }
+      node._hash = hash;
+    }
+  }  // MerkleTree::Build
+
+  std::size_t MerkleTree::GetNumberOfNodes( ) const
+  {
+    return this->_nodes.size( );
+  }
+
+  const MerkleNode &MerkleTree::GetNode( std::uint32_t index ) const
+  {
+    return this->_nodes[index];
+  }
+
+  std::string MerkleTree::GetPath( std::uint32_t index ) const
+  {
+    std::vector< const std::string * > spellings;
+    for ( std::uint32_t node = index; node != MerkleNode::none; node = this->_nodes[node]._parent ) {
+      if ( !this->_nodes[node]._spelling.empty( ) ) {
+        spellings.push_back( &this->_nodes[node]._spelling );
+      }
+    }
+
+    std::string path;
+    for ( auto spelling = spellings.rbegin( ); spelling != spellings.rend( ); ++spelling ) {
+      if ( !path.empty( ) ) {
+        path.append( "::" );
+      }
+      path.append( **spelling );
+    }
+    return path;
+  }  // MerkleTree::GetPath
+
+  std::size_t DiffMerkleTrees( const MerkleTree &before,
+                               const MerkleTree &after,
+                               std::vector< MerkleChange > &changes )
+  {
+    changes.clear( );
+    if ( ( before.GetNumberOfNodes( ) == 0 ) || ( after.GetNumberOfNodes( ) == 0 ) ) {
+      return 0;
+    }
+
+    std::size_t numberOfComparisons = 0;
+    std::vector< std::pair< std::uint32_t, std::uint32_t > > pairs{ { 0, 0 } };
+    // per key, the children of after not paired yet, in order.
+    std::unordered_map< std::string, std::vector< std::uint32_t > > unpaired;
+    std::vector< std::pair< std::uint32_t, std::uint32_t > > childPairs;
+    while ( !pairs.empty( ) ) {
+      const std::pair< std::uint32_t, std::uint32_t > pair = pairs.back( );
+      pairs.pop_back( );
+      ++numberOfComparisons;
+
+      const MerkleNode &beforeNode = before.GetNode( pair.first );
+      const MerkleNode &afterNode = after.GetNode( pair.second );
+      if ( beforeNode._hash == afterNode._hash ) {
+        continue;
+      }
+      if ( beforeNode._typeSpelling != afterNode._typeSpelling ) {
+        changes.push_back( MerkleChange{ MerkleChange::Kind::changed, pair.first, pair.second } );
+        continue;
+      }
+
+      unpaired.clear( );
+      // pushed backwards, such that each key pops its children in order.
+      for ( auto child = afterNode._children.rbegin( ); child != afterNode._children.rend( );
+            ++child ) {
+        unpaired[pairingKey( after.GetNode( *child ) )].push_back( *child );
+      }
+
+      childPairs.clear( );
+      bool isReordered = false;
+      std::uint32_t lastPaired = 0;
+      for ( const std::uint32_t child : beforeNode._children ) {
+        auto found = unpaired.find( pairingKey( before.GetNode( child ) ) );
+        if ( ( found == unpaired.end( ) ) || found->second.empty( ) ) {
+          changes.push_back( MerkleChange{ MerkleChange::Kind::removed, child, MerkleNode::none } );
+          continue;
+        }
+        const std::uint32_t partner = found->second.back( );
+        found->second.pop_back( );
+        // children are numbered in order: a partner numbered lower than the one before moved.
+        isReordered = isReordered || ( partner < lastPaired );
+        lastPaired = partner;
+        childPairs.emplace_back( child, partner );
+      }
+      // whatever is left unpaired is added, listed in the order of after.
+      for ( const std::uint32_t child : afterNode._children ) {
+        const auto found = unpaired.find( pairingKey( after.GetNode( child ) ) );
+        for ( const std::uint32_t left : found->second ) {
+          if ( left == child ) {
+            changes.push_back( MerkleChange{ MerkleChange::Kind::added, MerkleNode::none, child } );
+            break;
+          }
+        }
+      }
+      if ( isReordered ) {
+        changes.push_back( MerkleChange{ MerkleChange::Kind::changed, pair.first, pair.second } );
+      }
+
+      for ( auto childPair = childPairs.rbegin( ); childPair != childPairs.rend( ); ++childPair ) {
+        pairs.push_back( *childPair );
+      }
+    }
+    return numberOfComparisons;
+  }  // DiffMerkleTrees
+}  // namespace RomanoViolet
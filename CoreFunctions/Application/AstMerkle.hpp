@@ -0,0 +1,79 @@
+#ifndef _ASTMERKLE_HPP_
+#define _ASTMERKLE_HPP_
+
+#include <clang-c/Index.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief A cursor of a MerkleTree. Nodes are numbered in pre-order: the root is 0, and the
+   * descendants of a node follow it.
+   */
+  struct MerkleNode {
+    static constexpr std::uint32_t none = 0xFFFFFFFFU;
+
+    CXCursorKind _kind;
+    std::string _spelling;
+    std::string _typeSpelling;
+    // where the cursor is, for reports. Not part of the hash: moving a declaration does not
+    // change it.
+    unsigned _line;
+    unsigned _column;
+    // of the kind, spelling and type of the node, followed by the hashes of its children, in order.
+    std::uint64_t _hash;
+    std::uint32_t _parent;
+    std::vector< std::uint32_t > _children;
+  };
+
+  /**
+   * @brief The AST of a translation unit, with a structural hash per subtree. Two subtrees with the
+   * same hash are taken to be equal, without comparing them any further. Cursors in system
+   * headers are left out, as AstDump leaves them out.
+   */
+  class MerkleTree
+  {
+  public:
+    MerkleTree( );
+
+    // Replaces the tree by the one of tu.
+    void Build( CXTranslationUnit tu );
+
+    std::size_t GetNumberOfNodes( ) const;
+    const MerkleNode &GetNode( std::uint32_t index ) const;
+
+    // The spellings of the named ancestors of the node and of the node, e.g.,
+    // RomanoViolet::Component::c. The translation unit is left out.
+    std::string GetPath( std::uint32_t index ) const;
+
+  private:
+    std::vector< MerkleNode > _nodes;
+  };  // class MerkleTree
+
+  // A subtree found in one of the trees diffed only, or changed in place.
+  struct MerkleChange {
+    enum class Kind { added, removed, changed };
+
+    Kind _kind;
+    // MerkleNode::none for added subtrees.
+    std::uint32_t _before;
+    // MerkleNode::none for removed subtrees.
+    std::uint32_t _after;
+  };
+
+  /**
+   * @brief Lists the smallest subtrees telling before and after apart. The changes among the
+   * children of a node are listed before those further down.
+   * @details Children are paired by kind and spelling, the n-th of a kind and spelling in before
+   * with the n-th in after. Pairs with equal hashes are skipped without being descended into.
+   * A pair whose type differs, or whose children are paired alike but ordered differently, is
+   * changed as a whole.
+   * @return The number of pairs of subtrees compared.
+   */
+  std::size_t DiffMerkleTrees( const MerkleTree &before,
+                               const MerkleTree &after,
+                               std::vector< MerkleChange > &changes );
+}  // namespace RomanoViolet
+#endif  // !_ASTMERKLE_HPP_
@@ -0,0 +1,235 @@
+#include "AstSnapshot.hpp"
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace RomanoViolet
+{
+  namespace
+  {
+    const char magic[] = "ASTSNAP1";
+    constexpr std::size_t magicLength = sizeof( magic ) - 1;
+    constexpr std::size_t headerSize = magicLength + 2 * sizeof( std::uint32_t );
+    static_assert( sizeof( AstSnapshotNode ) == 12 * sizeof( std::uint32_t ),
+                   "The nodes are mapped in place, and must not be padded." );
+
+    void appendNumber( std::string &out, std::uint32_t value )
+    {
+      for ( std::size_t i = 0; i < sizeof( value ); ++i ) {
+        out.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xFFU ) );
+      }
+    }
+
+    // The snapshot is little endian; mapped nodes are only meaningful on such a host.
+    bool isLittleEndian( )
+    {
+      const std::uint32_t one = 1;
+      return *reinterpret_cast< const unsigned char * >( &one ) == 1;
+    }
+
+    // Nodes are numbered in pre-order, as AstSnapshotWriter adds them: a parent comes before its
+    // children, and a child or sibling after the node. Walks along the links then end, and stay
+    // within the nodes, whatever the file holds.
+    bool areLinksValid( const AstSnapshotNode *nodes, std::uint32_t numberOfNodes )
+    {
+      for ( std::uint32_t index = 0; index < numberOfNodes; ++index ) {
+        const AstSnapshotNode &node = nodes[index];
+        if ( ( ( node._parent != AstSnapshotNode::none ) && ( node._parent >= index ) )
+             || ( ( node._firstChild != AstSnapshotNode::none )
+                  && ( ( node._firstChild <= index ) || ( node._firstChild >= numberOfNodes ) ) )
+             || ( ( node._nextSibling != AstSnapshotNode::none )
+                  && ( ( node._nextSibling <= index )
+                       || ( node._nextSibling >= numberOfNodes ) ) ) ) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }  // namespace
+
+  constexpr std::uint32_t AstSnapshotNode::none;
+
+  AstSnapshotWriter::AstSnapshotWriter( ) : _nodes( ), _lastChildren( ), _strings( 1, '\0' ), _offsets( )
+  {
+    this->_offsets.emplace( std::string( ), 0 );
+  }
+
+  std::uint32_t AstSnapshotWriter::AddString( CXString string )
+  {
+    const char *data = clang_getCString( string );
+    std::string key( ( data != nullptr ) ? data : "" );
+    clang_disposeString( string );
+
+    const auto found = this->_offsets.find( key );
+    if ( found != this->_offsets.end( ) ) {
+      return found->second;
+    }
+    const std::uint32_t offset = static_cast< std::uint32_t >( this->_strings.size( ) );
+    this->_strings.append( key );
+    this->_strings.push_back( '\0' );
+    this->_offsets.emplace( std::move( key ), offset );
+    return offset;
+  }  // AstSnapshotWriter::AddString
+
+  std::uint32_t AstSnapshotWriter::Add( CXCursor cursor, std::uint32_t parent )
+  {
+    AstSnapshotNode node;
+    node._kind = static_cast< std::uint32_t >( clang_getCursorKind( cursor ) );
+    node._hash = clang_hashCursor( cursor );
+    node._spelling = this->AddString( clang_getCursorSpelling( cursor ) );
+    node._typeSpelling = this->AddString( clang_getTypeSpelling( clang_getCursorType( cursor ) ) );
+
+    const CXSourceRange range = clang_getCursorExtent( cursor );
+    CXFile file;
+    unsigned offset;
+    clang_getSpellingLocation(
+        clang_getRangeStart( range ), &file, &node._startLine, &node._startColumn, &offset );
+    clang_getSpellingLocation(
+        clang_getRangeEnd( range ), nullptr, &node._endLine, &node._endColumn, nullptr );
+    node._file = ( file != nullptr ) ? this->AddString( clang_getFileName( file ) ) : 0;
+
+    node._parent = parent;
+    node._firstChild = AstSnapshotNode::none;
+    node._nextSibling = AstSnapshotNode::none;
+
+    const std::uint32_t index = static_cast< std::uint32_t >( this->_nodes.size( ) );
+    if ( parent != AstSnapshotNode::none ) {
+      std::uint32_t &lastChild = this->_lastChildren[parent];
+      if ( lastChild == AstSnapshotNode::none ) {
+        this->_nodes[parent]._firstChild = index;
+      } else {
+        this->_nodes[lastChild]._nextSibling = index;
+      }
+      lastChild = index;
+    }
+    this->_nodes.push_back( node );
+    this->_lastChildren.push_back( AstSnapshotNode::none );
+    return index;
+  }  // AstSnapshotWriter::Add
+
+  std::size_t AstSnapshotWriter::GetNumberOfNodes( ) const
+  {
+    return this->_nodes.size( );
+  }
+
+  bool AstSnapshotWriter::Write( const std::string &path ) const
+  {
+    std::ofstream out( path, std::ios::binary | std::ios::trunc );
+    if ( !out ) {
+      return false;
+    }
+
+    std::string data( magic, magicLength );
+    data.reserve( headerSize + this->_nodes.size( ) * sizeof( AstSnapshotNode )
+                  + this->_strings.size( ) );
+    appendNumber( data, static_cast< std::uint32_t >( this->_nodes.size( ) ) );
+    appendNumber( data, static_cast< std::uint32_t >( this->_strings.size( ) ) );
+    for ( const AstSnapshotNode &node : this->_nodes ) {
+      const std::uint32_t fields[]
+          = { node._kind,    node._hash,        node._spelling,  node._typeSpelling,
+              node._file,    node._startLine,   node._startColumn, node._endLine,
+              node._endColumn, node._parent,    node._firstChild,  node._nextSibling };
+      for ( const std::uint32_t field : fields ) {
+        appendNumber( data, field );
+      }
+    }
+    data.append( this->_strings );
+
+    out.write( data.data( ), static_cast< std::streamsize >( data.size( ) ) );
+    return out.good( );
+  }  // AstSnapshotWriter::Write
+
+  AstSnapshot::AstSnapshot( )
+      : _mapping( nullptr )
+      , _size( 0 )
+      , _nodes( nullptr )
+      , _numberOfNodes( 0 )
+      , _strings( nullptr )
+      , _stringsSize( 0 )
+  {
+  }
+
+  AstSnapshot::~AstSnapshot( )
+  {
+    this->Close( );
+  }
+
+  void AstSnapshot::Close( )
+  {
+    if ( this->_mapping != nullptr ) {
+      munmap( this->_mapping, this->_size );
+    }
+    this->_mapping = nullptr;
+    this->_size = 0;
+    this->_nodes = nullptr;
+    this->_numberOfNodes = 0;
+    this->_strings = nullptr;
+    this->_stringsSize = 0;
+  }  // AstSnapshot::Close
+
+  bool AstSnapshot::Open( const std::string &path )
+  {
+    this->Close( );
+    if ( !isLittleEndian( ) ) {
+      return false;
+    }
+
+    const int descriptor = open( path.c_str( ), O_RDONLY );
+    if ( descriptor < 0 ) {
+      return false;
+    }
+    struct stat status;
+    if ( ( fstat( descriptor, &status ) != 0 )
+         || ( static_cast< std::size_t >( status.st_size ) < headerSize ) ) {
+      close( descriptor );
+      return false;
+    }
+    this->_size = static_cast< std::size_t >( status.st_size );
+    void *mapping = mmap( nullptr, this->_size, PROT_READ, MAP_PRIVATE, descriptor, 0 );
+    // the mapping stays valid once the descriptor is closed.
+    close( descriptor );
+    if ( mapping == MAP_FAILED ) {
+      this->_size = 0;
+      return false;
+    }
+    this->_mapping = mapping;
+
+    const char *data = static_cast< const char * >( mapping );
+    std::uint32_t counts[2];
+    std::memcpy( counts, data + magicLength, sizeof( counts ) );
+    const std::size_t nodesSize = static_cast< std::size_t >( counts[0] ) * sizeof( AstSnapshotNode );
+    if ( ( std::string( data, magicLength ).compare( magic ) != 0 )
+         || ( ( this->_size - headerSize ) / sizeof( AstSnapshotNode ) < counts[0] )
+         || ( this->_size - headerSize - nodesSize != counts[1] ) || ( counts[1] == 0 )
+         || ( data[this->_size - 1] != '\0' )
+         || !areLinksValid( reinterpret_cast< const AstSnapshotNode * >( data + headerSize ),
+                            counts[0] ) ) {
+      this->Close( );
+      return false;
+    }
+
+    this->_numberOfNodes = counts[0];
+    this->_nodes = reinterpret_cast< const AstSnapshotNode * >( data + headerSize );
+    this->_strings = data + headerSize + nodesSize;
+    this->_stringsSize = counts[1];
+    return true;
+  }  // AstSnapshot::Open
+
+  std::uint32_t AstSnapshot::GetNumberOfNodes( ) const
+  {
+    return this->_numberOfNodes;
+  }
+
+  const AstSnapshotNode &AstSnapshot::GetNode( std::uint32_t index ) const
+  {
+    return this->_nodes[index];
+  }
+
+  StringRef AstSnapshot::GetString( std::uint32_t offset ) const
+  {
+    // offsets beyond the table are treated as the empty string, rather than read out of bounds.
+    return ( offset < this->_stringsSize ) ? StringRef( this->_strings + offset ) : StringRef( );
+  }
+}  // namespace RomanoViolet
@@ -0,0 +1,111 @@
+#ifndef _ASTSNAPSHOT_HPP_
+#define _ASTSNAPSHOT_HPP_
+
+#include "StringPool.hpp"
+#include <clang-c/Index.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief A cursor of a frozen AST, as laid out in a snapshot file. Strings are offsets into the
+   * string table of the snapshot, nodes are indices into its nodes, or none.
+   */
+  struct AstSnapshotNode {
+    static constexpr std::uint32_t none = 0xFFFFFFFFU;
+
+    std::uint32_t _kind;
+    // clang_hashCursor.
+    std::uint32_t _hash;
+    std::uint32_t _spelling;
+    std::uint32_t _typeSpelling;
+    // the file of the extent, empty for the translation unit.
+    std::uint32_t _file;
+    std::uint32_t _startLine;
+    std::uint32_t _startColumn;
+    // the end is one past the last character, as clang_getCursorExtent reports it.
+    std::uint32_t _endLine;
+    std::uint32_t _endColumn;
+    std::uint32_t _parent;
+    std::uint32_t _firstChild;
+    std::uint32_t _nextSibling;
+  };
+
+  /**
+   * @brief Collects cursors into a snapshot, and writes it.
+   * @details Layout, all integers little endian, such that the file can be mapped and used in
+   * place (see AstSnapshot):
+   *   "ASTSNAP1", u32 number of nodes, u32 size of the string table,
+   *   the nodes, 12 u32 each, in the order of AstSnapshotNode,
+   *   the string table: NUL-terminated strings, each stored once. Offset 0 is the empty string.
+   * Node 0 is the root, usually the translation unit. Nodes are numbered in the order added.
+   */
+  class AstSnapshotWriter
+  {
+  public:
+    AstSnapshotWriter( );
+    AstSnapshotWriter( const AstSnapshotWriter & ) = delete;
+    AstSnapshotWriter &operator=( const AstSnapshotWriter & ) = delete;
+
+    /**
+     * @brief Adds cursor as the last child of parent, a node added before, or as the root.
+     * @param parent: AstSnapshotNode::none for the root.
+     * @return The index of the node.
+     */
+    std::uint32_t Add( CXCursor cursor, std::uint32_t parent );
+
+    std::size_t GetNumberOfNodes( ) const;
+
+    // false if the snapshot could not be written.
+    bool Write( const std::string &path ) const;
+
+  private:
+    std::vector< AstSnapshotNode > _nodes;
+    // per node: its last child so far, for linking the next one.
+    std::vector< std::uint32_t > _lastChildren;
+    std::string _strings;
+    std::unordered_map< std::string, std::uint32_t > _offsets;
+
+    std::uint32_t AddString( CXString string );
+  };  // class AstSnapshotWriter
+
+  /**
+   * @brief A snapshot written by AstSnapshotWriter, mapped into memory read only. Nodes and strings
+   * are used in place: opening costs a validation of the header and of the links between the
+   * nodes, not a parse.
+   */
+  class AstSnapshot
+  {
+  public:
+    AstSnapshot( );
+    ~AstSnapshot( );
+    AstSnapshot( const AstSnapshot & ) = delete;
+    AstSnapshot &operator=( const AstSnapshot & ) = delete;
+
+    /**
+     * @brief Maps the snapshot at path.
+     * @return false if it cannot be mapped, is not a snapshot, is truncated, or links a node to
+     * one which is out of range or out of the order nodes are added in.
+     */
+    bool Open( const std::string &path );
+
+    std::uint32_t GetNumberOfNodes( ) const;
+    const AstSnapshotNode &GetNode( std::uint32_t index ) const;
+    // The string at offset of the string table.
+    StringRef GetString( std::uint32_t offset ) const;
+
+  private:
+    void *_mapping;
+    std::size_t _size;
+    const AstSnapshotNode *_nodes;
+    std::uint32_t _numberOfNodes;
+    const char *_strings;
+    std::uint32_t _stringsSize;
+
+    void Close( );
+  };  // class AstSnapshot
+}  // namespace RomanoViolet
+#endif  // !_ASTSNAPSHOT_HPP_
@@ -0,0 +1,147 @@
+#include "BatchMode.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <fstream>
+#include <mutex>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+namespace RomanoViolet
+{
+  namespace
+  {
+    bool isHeader( const std::string &path )
+    {
+      const std::size_t dot = path.rfind( '.' );
+      if ( dot == std::string::npos ) {
+        return false;
+      }
+      const std::string extension = path.substr( dot );
+      return ( extension.compare( ".h" ) == 0 ) || ( extension.compare( ".hpp" ) == 0 );
+    }
+
+    void collectFromDirectory( const std::string &directory, std::vector< std::string > &headers )
+    {
+      DIR *handle = opendir( directory.c_str( ) );
+      if ( handle == nullptr ) {
+        return;
+      }
+
+      // directory order is file system dependent; sort in order to keep the batch deterministic.
+      std::vector< std::string > entries;
+      while ( const dirent *entry = readdir( handle ) ) {
+        const std::string name = entry->d_name;
+        if ( ( name.compare( "." ) != 0 ) && ( name.compare( ".." ) != 0 ) ) {
+          entries.emplace_back( directory + "/" + name );
+        }
+      }
+      closedir( handle );
+      std::sort( entries.begin( ), entries.end( ) );
+
+      for ( const std::string &entry : entries ) {
+        struct stat status;
+        if ( stat( entry.c_str( ), &status ) != 0 ) {
+          continue;
+        }
+        if ( S_ISDIR( status.st_mode ) ) {
+          collectFromDirectory( entry, headers );
+        } else if ( S_ISREG( status.st_mode ) && isHeader( entry ) ) {
+          headers.emplace_back( entry );
+        }
+      }
+    }
+  }  // namespace
+
+  bool CollectHeaders( const std::string &path, std::vector< std::string > &headers )
+  {
+    struct stat status;
+    if ( stat( path.c_str( ), &status ) != 0 ) {
+      return false;
+    }
+
+    if ( S_ISDIR( status.st_mode ) ) {
+      collectFromDirectory( path, headers );
+    } else {
+      headers.emplace_back( path );
+    }
+    return true;
+  }  // CollectHeaders
+
+  bool CollectHeadersFromList( const std::string &listFile, std::vector< std::string > &headers )
+  {
+    std::ifstream list( listFile );
+    if ( !list ) {
+      return false;
+    }
+
+    std::string line;
+    while ( std::getline( list, line ) ) {
+      if ( !line.empty( ) ) {
+        headers.emplace_back( line );
+      }
+    }
+    return true;
+  }  // CollectHeadersFromList
+
+  void RunBatch( const std::vector< std::string > &headers,
+                 unsigned jobs,
+                 const HeaderExtractor &extract,
+                 std::ostream &out,
+                 Instrumentation *instrumentation )
+  {
+    if ( jobs == 0 ) {
+      jobs = std::max( 1U, std::thread::hardware_concurrency( ) );
+    }
+    jobs = std::min< unsigned >( jobs, headers.size( ) );
+
+    // one slot per header: workers never write to the same slot, and the output does not depend
+    // on which worker processed which header.
+    std::vector< std::string > summaries( headers.size( ) );
+    std::vector< bool > isDone( headers.size( ), false );
+    std::atomic< std::size_t > next( 0 );
+
+    // summaries are written in the order of headers, each as soon as all previous ones are written.
+    std::mutex outMutex;
+    std::size_t nextToWrite = 0;
+
+    auto worker = [&]( ) {
+      const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now( );
+      CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                         /*displayDiagnostics=*/true );
+      if ( instrumentation != nullptr ) {
+        // workers run concurrently, so the time is recorded on its own and merged.
+        Instrumentation indexCreation;
+        indexCreation.AddTime( Instrumentation::Phase::INDEX_CREATION,
+                               std::chrono::steady_clock::now( ) - start );
+        instrumentation->Merge( indexCreation );
+      }
+      for ( std::size_t i = next++; i < headers.size( ); i = next++ ) {
+        std::ostringstream summary;
+        extract( index, headers[i], summary );
+
+        std::lock_guard< std::mutex > lock( outMutex );
+        summaries[i] = summary.str( );
+        isDone[i] = true;
+        for ( ; ( nextToWrite < headers.size( ) ) && isDone[nextToWrite]; ++nextToWrite ) {
+          out << summaries[nextToWrite];
+          summaries[nextToWrite].clear( );
+          summaries[nextToWrite].shrink_to_fit( );
+        }
+      }
+      clang_disposeIndex( index );
+    };
+
+    std::vector< std::thread > workers;
+    for ( unsigned i = 1; i < jobs; ++i ) {
+      workers.emplace_back( worker );
+    }
+    // the calling thread is a worker as well.
+    worker( );
+    for ( std::thread &thread : workers ) {
+      thread.join( );
+    }
+    out.flush( );
+  }  // RunBatch
+}  // namespace RomanoViolet
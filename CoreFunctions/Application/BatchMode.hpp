@@ -0,0 +1,52 @@
+#ifndef _BATCHMODE_HPP_
+#define _BATCHMODE_HPP_
+
+#include "Instrumentation.hpp"
+#include <clang-c/Index.h>
+#include <functional>
+#include <ostream>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Extracts the IO of one header, writing the summary into the provided stream.
+   * @details Called concurrently from several workers. The index passed in is owned by the calling
+   * worker and is never shared with another thread.
+   */
+  using HeaderExtractor
+      = std::function< void( CXIndex index, const std::string &header, std::ostream &out ) >;
+
+  /**
+   * @brief Appends the headers found at path to headers.
+   *
+   * @param path: A header, or a directory which is searched recursively for *.h and *.hpp files.
+   * Headers found in a directory are appended in sorted order.
+   * @return false if path is neither a readable file nor a readable directory.
+   */
+  bool CollectHeaders( const std::string &path, std::vector< std::string > &headers );
+
+  /**
+   * @brief Appends the headers listed in listFile, one path per line, to headers.
+   *
+   * @return false if listFile cannot be read.
+   */
+  bool CollectHeadersFromList( const std::string &listFile, std::vector< std::string > &headers );
+
+  /**
+   * @brief Extracts all headers on a pool of workers, one CXIndex per worker.
+   * @details Workers pick the next unprocessed header as soon as they are free. Each summary is
+   * buffered, and written to out in the order of headers as soon as the summaries of all previous
+   * headers are written, so the result does not depend on scheduling.
+   *
+   * @param jobs: Number of workers. 0 selects one worker per hardware thread.
+   * @param instrumentation: Receives the time spent creating the index of every worker, if not
+   * nullptr.
+   */
+  void RunBatch( const std::vector< std::string > &headers,
+                 unsigned jobs,
+                 const HeaderExtractor &extract,
+                 std::ostream &out,
+                 Instrumentation *instrumentation = nullptr );
+}  // namespace RomanoViolet
+#endif  // !_BATCHMODE_HPP_
@@ -0,0 +1,93 @@
+#include "BufferedWriter.hpp"
+namespace RomanoViolet
+{
+  BufferedWriter::BufferedWriter( std::ostream &out, std::size_t capacity )
+      : _out( out ), _buffer( ), _capacity( capacity )
+  {
+    this->_buffer.reserve( capacity );
+  }
+
+  BufferedWriter::~BufferedWriter( )
+  {
+    this->Flush( );
+  }
+
+  void BufferedWriter::Write( const char *data, std::size_t size )
+  {
+    if ( this->_buffer.size( ) + size > this->_capacity ) {
+      this->Flush( );
+    }
+    this->_buffer.append( data, size );
+  }  // BufferedWriter::Write
+
+  void BufferedWriter::Write( StringRef string )
+  {
+    this->Write( string.data( ), string.size( ) );
+  }  // BufferedWriter::Write
+
+  void BufferedWriter::Put( char character )
+  {
+    this->Write( &character, 1 );
+  }  // BufferedWriter::Put
+
+  void BufferedWriter::WriteLeft( StringRef string, std::size_t width )
+  {
+    this->Write( string );
+    if ( string.size( ) < width ) {
+      this->Pad( width - string.size( ) );
+    }
+  }  // BufferedWriter::WriteLeft
+
+  void BufferedWriter::WriteRight( StringRef string, std::size_t width )
+  {
+    if ( string.size( ) < width ) {
+      this->Pad( width - string.size( ) );
+    }
+    this->Write( string );
+  }  // BufferedWriter::WriteRight
+
+  void BufferedWriter::WriteInteger( long long value )
+  {
+    // digits are produced backwards, from the end of digits.
+    char digits[24];
+    char *first = digits + sizeof( digits );
+    unsigned long long magnitude
+        = ( value < 0 ) ? 0ULL - static_cast< unsigned long long >( value )
+                        : static_cast< unsigned long long >( value );
+    do {
+      *--first = static_cast< char >( '0' + magnitude % 10 );
+      magnitude /= 10;
+    } while ( magnitude != 0 );
+    if ( value < 0 ) {
+      *--first = '-';
+    }
+    this->Write( first, static_cast< std::size_t >( digits + sizeof( digits ) - first ) );
+  }  // BufferedWriter::WriteInteger
+
+  void BufferedWriter::WriteHexadecimal( unsigned long long value )
+  {
+    static const char hexadecimalDigits[] = "0123456789abcdef";
+    char digits[16];
+    for ( std::size_t i = sizeof( digits ); i > 0; --i ) {
+      digits[i - 1] = hexadecimalDigits[value & 0xFU];
+      value >>= 4;
+    }
+    this->Write( digits, sizeof( digits ) );
+  }  // BufferedWriter::WriteHexadecimal
+
+  void BufferedWriter::Pad( std::size_t count )
+  {
+    if ( this->_buffer.size( ) + count > this->_capacity ) {
+      this->Flush( );
+    }
+    this->_buffer.append( count, ' ' );
+  }  // BufferedWriter::Pad
+
+  void BufferedWriter::Flush( )
+  {
+    if ( !this->_buffer.empty( ) ) {
+      this->_out.write( this->_buffer.data( ), this->_buffer.size( ) );
+      this->_buffer.clear( );
+    }
+  }  // BufferedWriter::Flush
+}  // namespace RomanoViolet
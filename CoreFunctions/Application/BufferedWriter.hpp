@@ -0,0 +1,45 @@
+#ifndef _BUFFEREDWRITER_HPP_
+#define _BUFFEREDWRITER_HPP_
+
+#include "StringPool.hpp"
+#include <cstddef>
+#include <ostream>
+#include <string>
+namespace RomanoViolet
+{
+  /**
+   * @brief Collects output in a buffer of its own and hands it to the underlying stream in large
+   * chunks, without any iostream formatting or flushing in between. Flushes when destroyed.
+   */
+  class BufferedWriter
+  {
+  public:
+    explicit BufferedWriter( std::ostream &out, std::size_t capacity = 64 * 1024 );
+    ~BufferedWriter( );
+    BufferedWriter( const BufferedWriter & ) = delete;
+    BufferedWriter &operator=( const BufferedWriter & ) = delete;
+
+    void Write( const char *data, std::size_t size );
+    void Write( StringRef string );
+    void Put( char character );
+
+    // Write string, padded with spaces to at least width characters, as std::setw does.
+    void WriteLeft( StringRef string, std::size_t width );
+    void WriteRight( StringRef string, std::size_t width );
+    // Write value in decimal, without going through iostream formatting.
+    void WriteInteger( long long value );
+    // Write value as 16 hexadecimal digits, e.g., a hash.
+    void WriteHexadecimal( unsigned long long value );
+
+    // Hands the buffered output to the underlying stream. Does not flush the stream itself.
+    void Flush( );
+
+  private:
+    std::ostream &_out;
+    std::string _buffer;
+    const std::size_t _capacity;
+
+    void Pad( std::size_t count );
+  };  // class BufferedWriter
+}  // namespace RomanoViolet
+#endif  // !_BUFFEREDWRITER_HPP_
@@ -0,0 +1,88 @@
+#include "Cursor.hpp"
+#include <string>
+namespace RomanoViolet
+{
+  bool Cursor::IsNull( ) const
+  {
+    // asked rarely, so libclang is only asked when needed.
+    return this->_isNull
+           || ( ( this->_event == nullptr ) && ( clang_Cursor_isNull( this->_cursor ) != 0 ) );
+  }
+
+  StringRef Cursor::Spelling( StringPool &strings ) const
+  {
+    if ( this->_event != nullptr ) {
+      return strings.Intern( this->_event->_spelling );
+    }
+    return strings.Intern( clang_getCursorSpelling( this->_cursor ) );
+  }  // Cursor::Spelling
+
+  StringRef Cursor::TypeSpelling( StringPool &strings ) const
+  {
+    if ( this->_event != nullptr ) {
+      return strings.Intern( this->_event->_typeSpelling );
+    }
+    return strings.Intern( clang_getTypeSpelling( clang_getCursorType( this->_cursor ) ) );
+  }  // Cursor::TypeSpelling
+
+  CX_CXXAccessSpecifier Cursor::Access( ) const
+  {
+    return ( this->_event != nullptr ) ? this->_event->_access
+                                       : clang_getCXXAccessSpecifier( this->_cursor );
+  }
+
+  bool Cursor::IsFromMainFile( ) const
+  {
+    if ( this->_event != nullptr ) {
+      return this->_event->_isFromMainFile;
+    }
+    return clang_Location_isFromMainFile( clang_getCursorLocation( this->_cursor ) ) != 0;
+  }
+
+  bool Cursor::IsDefinition( ) const
+  {
+    return ( this->_event != nullptr ) ? this->_event->_isDefinition
+                                       : ( clang_isCursorDefinition( this->_cursor ) != 0 );
+  }
+
+  bool Cursor::IsAtNamespaceScope( ) const
+  {
+    if ( this->_event != nullptr ) {
+      return this->_event->_isAtNamespaceScope;
+    }
+    const CXCursorKind parentKind
+        = clang_getCursorKind( clang_getCursorSemanticParent( this->_cursor ) );
+    return ( parentKind == CXCursorKind::CXCursor_Namespace )
+           || ( parentKind == CXCursorKind::CXCursor_TranslationUnit );
+  }  // Cursor::IsAtNamespaceScope
+
+  StringRef Cursor::EnclosingNamespaces( StringPool &strings ) const
+  {
+    if ( this->_event != nullptr ) {
+      return strings.Intern( this->_event->_enclosingNamespaces );
+    }
+
+    std::string namespaces;
+    for ( CXCursor parent = clang_getCursorSemanticParent( this->_cursor );
+          clang_getCursorKind( parent ) == CXCursorKind::CXCursor_Namespace;
+          parent = clang_getCursorSemanticParent( parent ) ) {
+      const StringRef name = strings.Intern( clang_getCursorSpelling( parent ) );
+      namespaces.insert( 0, namespaces.empty( ) ? "" : "::" );
+      namespaces.insert( 0, name.data( ), name.size( ) );
+    }
+    return strings.Intern( StringRef( namespaces ) );
+  }  // Cursor::EnclosingNamespaces
+
+  bool Cursor::IsMemberOf( const Cursor &parent ) const
+  {
+    if ( parent.IsNull( ) ) {
+      return false;
+    }
+    // recorded cursors are only ever compared with recorded cursors.
+    if ( ( this->_event != nullptr ) || ( parent._event != nullptr ) ) {
+      return ( this->_event != nullptr ) && ( parent._event != nullptr )
+             && ( this->_event->_parent != 0 ) && ( this->_event->_parent == parent._event->_id );
+    }
+    return clang_equalCursors( clang_getCursorSemanticParent( this->_cursor ), parent._cursor ) != 0;
+  }  // Cursor::IsMemberOf
+}  // namespace RomanoViolet
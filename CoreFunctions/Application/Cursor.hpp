@@ -0,0 +1,79 @@
+#ifndef _CURSOR_HPP_
+#define _CURSOR_HPP_
+
+#include "StringPool.hpp"
+#include <clang-c/Index.h>
+#include <cstdint>
+namespace RomanoViolet
+{
+  /**
+   * @brief Everything StateMachine queries about a cursor, captured once, e.g., read back from a
+   * cursor log (see CursorLog.hpp).
+   */
+  struct CursorEvent {
+    CXCursorKind _kind = CXCursorKind::CXCursor_UnexposedDecl;
+    StringRef _spelling;
+    StringRef _typeSpelling;
+    CX_CXXAccessSpecifier _access = CX_CXXAccessSpecifier::CX_CXXInvalidAccessSpecifier;
+    bool _isFromMainFile = false;
+    bool _isDefinition = false;
+    // whether the semantic parent is a namespace or the translation unit.
+    bool _isAtNamespaceScope = false;
+    // class declarations only: e.g., "NN::RomanoViolet".
+    StringRef _enclosingNamespaces;
+    // class declarations only: identifies the class, starting at 1.
+    std::uint32_t _id = 0;
+    // field declarations only: _id of the semantic parent, 0 if not a recorded class.
+    std::uint32_t _parent = 0;
+  };
+
+  /**
+   * @brief The view of a cursor StateMachine works on. Either backed by libclang, in which case
+   * every query is forwarded to libclang when made, or by a CursorEvent, in which case libclang is
+   * not used at all. Cheap to copy; a CursorEvent must outlive the cursors referring to it.
+   */
+  class Cursor
+  {
+  public:
+    // A null cursor.
+    Cursor( ) : _cursor( ), _event( nullptr ), _isNull( true )
+    {
+    }
+
+    explicit Cursor( const CXCursor cursor ) : _cursor( cursor ), _event( nullptr ), _isNull( false )
+    {
+    }
+
+    explicit Cursor( const CursorEvent &event ) : _cursor( ), _event( &event ), _isNull( false )
+    {
+    }
+
+    bool IsNull( ) const;
+
+    // Inline, since it is asked for every cursor.
+    CXCursorKind Kind( ) const
+    {
+      return ( this->_event != nullptr ) ? this->_event->_kind : clang_getCursorKind( this->_cursor );
+    }
+
+    StringRef Spelling( StringPool &strings ) const;
+    // Spelling of the type of the cursor, e.g., of a field.
+    StringRef TypeSpelling( StringPool &strings ) const;
+    CX_CXXAccessSpecifier Access( ) const;
+    bool IsFromMainFile( ) const;
+    bool IsDefinition( ) const;
+    bool IsAtNamespaceScope( ) const;
+    // The namespaces enclosing the cursor, outermost first, e.g., "NN::RomanoViolet".
+    StringRef EnclosingNamespaces( StringPool &strings ) const;
+    // Whether parent, a class, is the semantic parent of the cursor.
+    bool IsMemberOf( const Cursor &parent ) const;
+
+  private:
+    CXCursor _cursor;
+    // not nullptr if backed by an event.
+    const CursorEvent *_event;
+    // whether default constructed.
+    bool _isNull;
+  };  // class Cursor
+}  // namespace RomanoViolet
+#endif  // !_CURSOR_HPP_
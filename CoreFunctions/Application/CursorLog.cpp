@@ -0,0 +1,265 @@
+#include "CursorLog.hpp"
+#include "StateMachine.hpp"
+#include <iterator>
+namespace RomanoViolet
+{
+  namespace
+  {
+    const char magic[] = "CURSORS1";
+    constexpr std::size_t magicLength = sizeof( magic ) - 1;
+    // a serialized event: kind (2 bytes), flags (1), spelling, type spelling, enclosing
+    // namespaces, id and parent (4 each).
+    constexpr std::size_t eventSize = 2 + 1 + 5 * 4;
+
+    void appendNumber( std::string &out, std::uint32_t value, std::size_t bytes )
+    {
+      for ( std::size_t i = 0; i < bytes; ++i ) {
+        out.push_back( static_cast< char >( ( value >> ( 8 * i ) ) & 0xFFU ) );
+      }
+    }
+
+    void appendString( std::string &out, const StringRef string )
+    {
+      appendNumber( out, static_cast< std::uint32_t >( string.size( ) ), 4 );
+      out.append( string.data( ), string.size( ) );
+    }
+
+    // Reads from a record, failing on any read beyond its end.
+    class Reader
+    {
+    public:
+      Reader( const std::string &data, std::size_t begin, std::size_t end )
+          : _data( data ), _position( begin ), _end( end )
+      {
+      }
+
+      bool Number( std::size_t bytes, std::uint32_t &value )
+      {
+        if ( this->_end - this->_position < bytes ) {
+          return false;
+        }
+        value = 0;
+        for ( std::size_t i = 0; i < bytes; ++i ) {
+          value |= static_cast< std::uint32_t >(
+                       static_cast< unsigned char >( this->_data[this->_position + i] ) )
+                   << ( 8 * i );
+        }
+        this->_position += bytes;
+        return true;
+      }
+
+      bool String( std::string &string )
+      {
+        std::uint32_t size;
+        if ( !this->Number( 4, size ) || ( this->_end - this->_position < size ) ) {
+          return false;
+        }
+        string.assign( this->_data, this->_position, size );
+        this->_position += size;
+        return true;
+      }
+
+      // The bytes left to read.
+      std::size_t Remaining( ) const
+      {
+        return this->_end - this->_position;
+      }
+
+    private:
+      const std::string &_data;
+      std::size_t _position;
+      const std::size_t _end;
+    };  // class Reader
+
+    bool readHeader( Reader &reader, RecordedHeader &header )
+    {
+      std::uint32_t inspectAllClasses;
+      std::uint32_t numberOfStrings;
+      if ( !reader.String( header._header ) || !reader.String( header._classToInspect )
+           || !reader.Number( 1, inspectAllClasses ) || !reader.Number( 4, numberOfStrings ) ) {
+        return false;
+      }
+      header._inspectAllClasses = ( inspectAllClasses != 0 );
+
+      std::vector< StringRef > strings( 1, StringRef( ) );
+      std::string string;
+      for ( std::uint32_t i = 0; i < numberOfStrings; ++i ) {
+        if ( !reader.String( string ) ) {
+          return false;
+        }
+        strings.emplace_back( header._strings.Intern( StringRef( string ) ) );
+      }
+
+      std::uint32_t numberOfEvents;
+      // the count is checked against the record before the events are allocated.
+      if ( !reader.Number( 4, numberOfEvents )
+           || ( reader.Remaining( ) / eventSize < numberOfEvents ) ) {
+        return false;
+      }
+      header._events.resize( numberOfEvents );
+      for ( CursorEvent &event : header._events ) {
+        std::uint32_t kind, flags, spelling, typeSpelling, enclosingNamespaces;
+        if ( !reader.Number( 2, kind ) || !reader.Number( 1, flags ) || !reader.Number( 4, spelling )
+             || !reader.Number( 4, typeSpelling ) || !reader.Number( 4, enclosingNamespaces )
+             || !reader.Number( 4, event._id ) || !reader.Number( 4, event._parent )
+             || ( spelling >= strings.size( ) ) || ( typeSpelling >= strings.size( ) )
+             || ( enclosingNamespaces >= strings.size( ) ) ) {
+          return false;
+        }
+        event._kind = static_cast< CXCursorKind >( kind );
+        event._isFromMainFile = ( ( flags & 0x1U ) != 0 );
+        event._isDefinition = ( ( flags & 0x2U ) != 0 );
+        event._isAtNamespaceScope = ( ( flags & 0x4U ) != 0 );
+        event._access = static_cast< CX_CXXAccessSpecifier >( ( flags >> 3 ) & 0x3U );
+        event._spelling = strings[spelling];
+        event._typeSpelling = strings[typeSpelling];
+        event._enclosingNamespaces = strings[enclosingNamespaces];
+      }
+      return true;
+    }  // readHeader
+  }  // namespace
+
+  CursorRecorder::CursorRecorder( const std::string &header,
+                                  const std::string &classToInspect,
+                                  bool inspectAllClasses )
+      : _header( header )
+      , _classToInspect( classToInspect )
+      , _inspectAllClasses( inspectAllClasses )
+      , _events( )
+      , _pool( )
+      , _strings( 1, StringRef( ) )
+      , _stringIds( )
+      , _classes( )
+  {
+  }
+
+  std::uint32_t CursorRecorder::StringId( const StringRef string )
+  {
+    if ( string.empty( ) ) {
+      return 0;
+    }
+    const auto known = this->_stringIds.find( string.data( ) );
+    if ( known != this->_stringIds.end( ) ) {
+      return known->second;
+    }
+    const std::uint32_t id = static_cast< std::uint32_t >( this->_strings.size( ) );
+    this->_strings.emplace_back( string );
+    this->_stringIds.emplace( string.data( ), id );
+    return id;
+  }  // CursorRecorder::StringId
+
+  void CursorRecorder::Record( const CXCursor cursor )
+  {
+    const Cursor view( cursor );
+    const CXCursorKind kind = view.Kind( );
+    if ( !StateMachine::IsHandled( kind ) ) {
+      return;
+    }
+
+    Event event;
+    event._kind = static_cast< std::uint16_t >( kind );
+    event._flags = static_cast< std::uint8_t >(
+        ( view.IsFromMainFile( ) ? 0x1U : 0U ) | ( view.IsDefinition( ) ? 0x2U : 0U )
+        | ( view.IsAtNamespaceScope( ) ? 0x4U : 0U )
+        | ( ( static_cast< unsigned >( view.Access( ) ) & 0x3U ) << 3 ) );
+    event._spelling = this->StringId( view.Spelling( this->_pool ) );
+    event._typeSpelling = this->StringId( view.TypeSpelling( this->_pool ) );
+    event._enclosingNamespaces = 0;
+    event._id = 0;
+    event._parent = 0;
+
+    if ( kind == CXCursorKind::CXCursor_ClassDecl ) {
+      event._enclosingNamespaces = this->StringId( view.EnclosingNamespaces( this->_pool ) );
+      event._id = static_cast< std::uint32_t >( this->_classes.size( ) + 1 );
+      this->_classes.emplace_back( cursor, event._id );
+    } else if ( kind == CXCursorKind::CXCursor_FieldDecl ) {
+      // fields follow their class, so the search from the back is short.
+      for ( auto recorded = this->_classes.rbegin( ); recorded != this->_classes.rend( );
+            ++recorded ) {
+        if ( view.IsMemberOf( Cursor( recorded->first ) ) ) {
+          event._parent = recorded->second;
+          break;
+        }
+      }
+    }
+    this->_events.emplace_back( event );
+  }  // CursorRecorder::Record
+
+  std::string CursorRecorder::Serialize( ) const
+  {
+    std::string record;
+    appendString( record, StringRef( this->_header ) );
+    appendString( record, StringRef( this->_classToInspect ) );
+    appendNumber( record, this->_inspectAllClasses ? 1 : 0, 1 );
+    appendNumber( record, static_cast< std::uint32_t >( this->_strings.size( ) - 1 ), 4 );
+    for ( std::size_t i = 1; i < this->_strings.size( ); ++i ) {
+      appendString( record, this->_strings[i] );
+    }
+    appendNumber( record, static_cast< std::uint32_t >( this->_events.size( ) ), 4 );
+    for ( const Event &event : this->_events ) {
+      appendNumber( record, event._kind, 2 );
+      appendNumber( record, event._flags, 1 );
+      appendNumber( record, event._spelling, 4 );
+      appendNumber( record, event._typeSpelling, 4 );
+      appendNumber( record, event._enclosingNamespaces, 4 );
+      appendNumber( record, event._id, 4 );
+      appendNumber( record, event._parent, 4 );
+    }
+    return record;
+  }  // CursorRecorder::Serialize
+
+  CursorLogWriter::CursorLogWriter( const std::string &path )
+      : _out( path, std::ios::binary | std::ios::trunc ), _mutex( )
+  {
+    this->_out.write( magic, magicLength );
+  }
+
+  bool CursorLogWriter::IsOpen( ) const
+  {
+    return this->_out.good( );
+  }
+
+  void CursorLogWriter::Append( const CursorRecorder &recorder )
+  {
+    const std::string record = recorder.Serialize( );
+    std::string length;
+    appendNumber( length, static_cast< std::uint32_t >( record.size( ) ), 4 );
+
+    std::lock_guard< std::mutex > lock( this->_mutex );
+    this->_out.write( length.data( ), length.size( ) );
+    this->_out.write( record.data( ), record.size( ) );
+  }  // CursorLogWriter::Append
+
+  bool ReadCursorLog( const std::string &path,
+                      std::vector< std::unique_ptr< RecordedHeader > > &headers )
+  {
+    std::ifstream in( path, std::ios::binary );
+    if ( !in ) {
+      return false;
+    }
+    const std::string data{ std::istreambuf_iterator< char >( in ),
+                            std::istreambuf_iterator< char >( ) };
+    if ( data.compare( 0, magicLength, magic ) != 0 ) {
+      return false;
+    }
+
+    std::size_t position = magicLength;
+    while ( position < data.size( ) ) {
+      std::uint32_t length;
+      Reader prefix( data, position, data.size( ) );
+      if ( !prefix.Number( 4, length ) || ( data.size( ) - position - 4 < length ) ) {
+        return false;
+      }
+      position += 4;
+
+      Reader reader( data, position, position + length );
+      std::unique_ptr< RecordedHeader > header( new RecordedHeader );
+      if ( !readHeader( reader, *header ) ) {
+        return false;
+      }
+      headers.emplace_back( std::move( header ) );
+      position += length;
+    }
+    return true;
+  }  // ReadCursorLog
+}  // namespace RomanoViolet
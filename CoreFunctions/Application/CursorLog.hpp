@@ -0,0 +1,112 @@
+#ifndef _CURSORLOG_HPP_
+#define _CURSORLOG_HPP_
+
+#include "Cursor.hpp"
+#include "StringPool.hpp"
+#include <clang-c/Index.h>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Records the cursors fed to StateMachine::AdvanceStateMachine during the extraction of
+   * one header, along with everything the state machine queries about them.
+   * @details Cursors of kinds the state machine ignores (see StateMachine::IsHandled) are dropped,
+   * since they cannot influence the result. Spellings are stored once per header.
+   */
+  class CursorRecorder
+  {
+  public:
+    /**
+     * @param classToInspect, inspectAllClasses: The arguments the state machine was constructed
+     * with, so that a replay constructs the same one.
+     */
+    CursorRecorder( const std::string &header,
+                    const std::string &classToInspect,
+                    bool inspectAllClasses );
+
+    void Record( const CXCursor cursor );
+
+    // The record of the header, see CursorLogWriter for the layout.
+    std::string Serialize( ) const;
+
+  private:
+    struct Event {
+      std::uint16_t _kind;
+      // bit 0: from main file, bit 1: definition, bit 2: at namespace scope, bits 3-4: access.
+      std::uint8_t _flags;
+      std::uint32_t _spelling;
+      std::uint32_t _typeSpelling;
+      std::uint32_t _enclosingNamespaces;
+      std::uint32_t _id;
+      std::uint32_t _parent;
+    };
+
+    const std::string _header;
+    const std::string _classToInspect;
+    const bool _inspectAllClasses;
+    std::vector< Event > _events;
+    // spellings are interned here, so that a string is identified by the address of its data.
+    StringPool _pool;
+    // string table; index 0 is the empty string.
+    std::vector< StringRef > _strings;
+    std::unordered_map< const char *, std::uint32_t > _stringIds;
+    // class declarations recorded so far, for resolving the semantic parent of fields.
+    std::vector< std::pair< CXCursor, std::uint32_t > > _classes;
+
+    std::uint32_t StringId( const StringRef string );
+  };  // class CursorRecorder
+
+  /**
+   * @brief Appends the records of headers to a cursor log file.
+   * @details Layout, all integers little endian, strings are a u32 length followed by the bytes:
+   *   "CURSORS1"
+   *   per header: u32 length of the remainder of the record,
+   *     str header, str class to inspect, u8 inspect all classes,
+   *     u32 number of strings, str... (string 0, the empty string, is not stored),
+   *     u32 number of cursors, each of which is
+   *       u16 CXCursorKind, u8 flags (see CursorRecorder::Event), u32 spelling, u32 type spelling,
+   *       u32 enclosing namespaces (strings by index), u32 class id, u32 parent class id.
+   * Records are appended as headers complete, so with batch workers, their order may differ from
+   * the order of the headers. Safe to share between batch workers.
+   */
+  class CursorLogWriter
+  {
+  public:
+    explicit CursorLogWriter( const std::string &path );
+
+    // false if the log could not be opened.
+    bool IsOpen( ) const;
+    void Append( const CursorRecorder &recorder );
+
+  private:
+    std::ofstream _out;
+    std::mutex _mutex;
+  };  // class CursorLogWriter
+
+  /**
+   * @brief The record of one header, read back from a cursor log.
+   */
+  struct RecordedHeader {
+    std::string _header;
+    std::string _classToInspect;
+    bool _inspectAllClasses = false;
+    // the events refer to strings in here.
+    StringPool _strings;
+    std::vector< CursorEvent > _events;
+  };
+
+  /**
+   * @brief Reads all records of the cursor log at path.
+   * @return false if the file cannot be read or is not a cursor log.
+   */
+  bool ReadCursorLog( const std::string &path,
+                      std::vector< std::unique_ptr< RecordedHeader > > &headers );
+}  // namespace RomanoViolet
+#endif  // !_CURSORLOG_HPP_
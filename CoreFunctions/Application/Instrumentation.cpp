@@ -0,0 +1,206 @@
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <iomanip>
+namespace RomanoViolet
+{
+  namespace
+  {
+    const char *const phaseNames[] = { "index creation", "parse", "traversal", "printing" };
+    const char *const phaseKeys[] = { "index_creation", "parse", "traversal", "printing" };
+
+    const char *const stateNames[] = { "INIT",
+                                       "NAMESPACE_COLLECTION",
+                                       "CLASSNAME_COLLECTION",
+                                       "BASENAME_COLLECTION",
+                                       "IONAME_COLLECTION",
+                                       "IONAMESPACE_COLLECTION",
+                                       "IODIRECTION_COLLECTION",
+                                       "IOTYPE_COLLECTION",
+                                       "IDLE_AFTER_BASENAMECOLLECTION",
+                                       "IDLE_AFTER_IODIRECTIONCOLLECTION" };
+
+    std::string cursorKindName( int kind )
+    {
+      CXString spelling = clang_getCursorKindSpelling( static_cast< CXCursorKind >( kind ) );
+      const std::string name = clang_getCString( spelling );
+      clang_disposeString( spelling );
+      return name;
+    }
+
+    double milliseconds( std::chrono::steady_clock::duration duration )
+    {
+      return std::chrono::duration< double, std::milli >( duration ).count( );
+    }
+  }  // namespace
+
+  Instrumentation::Timer::Timer( Instrumentation *instrumentation, Phase phase )
+      : _instrumentation( instrumentation )
+      , _phase( phase )
+      , _start( ( instrumentation != nullptr ) ? std::chrono::steady_clock::now( )
+                                               : std::chrono::steady_clock::time_point( ) )
+  {
+  }
+
+  Instrumentation::Timer::~Timer( )
+  {
+    if ( this->_instrumentation != nullptr ) {
+      this->_instrumentation->AddTime( this->_phase, std::chrono::steady_clock::now( ) - this->_start );
+    }
+  }
+
+  Instrumentation::Instrumentation( )
+      : _phases( )
+      , _cursors( )
+      , _transitions( )
+      , _rollbacks( 0 )
+      , _fastPathTaken( 0 )
+      , _fastPathFallbacks( 0 )
+      , _resources( )
+      , _peakResourceTotal( 0 )
+      , _translationUnits( 0 )
+      , _mergeMutex( )
+  {
+    this->_transitions.fill( 0 );
+  }
+
+  void Instrumentation::AddTime( Phase phase, std::chrono::steady_clock::duration duration )
+  {
+    PhaseTime &phaseTime = this->_phases[static_cast< std::size_t >( phase )];
+    ++phaseTime._calls;
+    phaseTime._time += duration;
+  }  // Instrumentation::AddTime
+
+  void Instrumentation::CountCursor( CXCursorKind kind )
+  {
+    ++this->_cursors[static_cast< int >( kind )];
+  }  // Instrumentation::CountCursor
+
+  void Instrumentation::CountTransition( StateMachine::State state )
+  {
+    ++this->_transitions[static_cast< std::size_t >( state )];
+  }  // Instrumentation::CountTransition
+
+  void Instrumentation::CountRollback( )
+  {
+    ++this->_rollbacks;
+  }  // Instrumentation::CountRollback
+
+  void Instrumentation::CountFastPath( bool isTaken )
+  {
+    ++( isTaken ? this->_fastPathTaken : this->_fastPathFallbacks );
+  }  // Instrumentation::CountFastPath
+
+  void Instrumentation::RecordResourceUsage( CXTranslationUnit tu )
+  {
+    CXTUResourceUsage usage = clang_getCXTUResourceUsage( tu );
+    unsigned long total = 0;
+    for ( unsigned i = 0; i < usage.numEntries; ++i ) {
+      const CXTUResourceUsageEntry &entry = usage.entries[i];
+      unsigned long &peak = this->_resources[clang_getTUResourceUsageName( entry.kind )];
+      peak = std::max( peak, entry.amount );
+      total += entry.amount;
+    }
+    clang_disposeCXTUResourceUsage( usage );
+    this->_peakResourceTotal = std::max( this->_peakResourceTotal, total );
+    ++this->_translationUnits;
+  }  // Instrumentation::RecordResourceUsage
+
+  void Instrumentation::Merge( const Instrumentation &other )
+  {
+    std::lock_guard< std::mutex > lock( this->_mergeMutex );
+    for ( std::size_t i = 0; i < numberOfPhases; ++i ) {
+      this->_phases[i]._calls += other._phases[i]._calls;
+      this->_phases[i]._time += other._phases[i]._time;
+    }
+    for ( const auto &cursor : other._cursors ) {
+      this->_cursors[cursor.first] += cursor.second;
+    }
+    for ( std::size_t i = 0; i < numberOfStates; ++i ) {
+      this->_transitions[i] += other._transitions[i];
+    }
+    this->_rollbacks += other._rollbacks;
+    this->_fastPathTaken += other._fastPathTaken;
+    this->_fastPathFallbacks += other._fastPathFallbacks;
+    for ( const auto &resource : other._resources ) {
+      unsigned long &peak = this->_resources[resource.first];
+      peak = std::max( peak, resource.second );
+    }
+    this->_peakResourceTotal = std::max( this->_peakResourceTotal, other._peakResourceTotal );
+    this->_translationUnits += other._translationUnits;
+  }  // Instrumentation::Merge
+
+  void Instrumentation::WriteSummary( std::ostream &out ) const
+  {
+    out << std::fixed << std::setprecision( 3 );
+    out << "Phase" << std::setw( 35 ) << "Calls" << std::setw( 15 ) << "Time (ms)"
+        << "\n";
+    for ( std::size_t i = 0; i < numberOfPhases; ++i ) {
+      out << "  " << std::left << std::setw( 28 ) << phaseNames[i] << std::right << std::setw( 10 )
+          << this->_phases[i]._calls << std::setw( 15 ) << milliseconds( this->_phases[i]._time )
+          << "\n";
+    }
+
+    std::size_t cursors = 0;
+    for ( const auto &cursor : this->_cursors ) {
+      cursors += cursor.second;
+    }
+    out << "Visited cursors" << std::setw( 25 ) << cursors << "\n";
+    for ( const auto &cursor : this->_cursors ) {
+      out << "  " << std::left << std::setw( 28 ) << cursorKindName( cursor.first ) << std::right
+          << std::setw( 10 ) << cursor.second << "\n";
+    }
+
+    out << "State transitions into\n";
+    for ( std::size_t i = 0; i < numberOfStates; ++i ) {
+      out << "  " << std::left << std::setw( 34 ) << stateNames[i] << std::right << std::setw( 4 )
+          << this->_transitions[i] << "\n";
+    }
+    out << "Rollbacks to INIT" << std::setw( 23 ) << this->_rollbacks << "\n";
+    if ( ( this->_fastPathTaken + this->_fastPathFallbacks ) > 0 ) {
+      out << "Fast path taken" << std::setw( 25 ) << this->_fastPathTaken << "\n";
+      out << "Fast path fell back" << std::setw( 21 ) << this->_fastPathFallbacks << "\n";
+    }
+
+    out << "libclang memory, peak over " << this->_translationUnits
+        << " translation units (bytes)\n";
+    for ( const auto &resource : this->_resources ) {
+      out << "  " << std::left << std::setw( 48 ) << resource.first << std::right
+          << std::setw( 12 ) << resource.second << "\n";
+    }
+    out << "  " << std::left << std::setw( 48 ) << "total" << std::right << std::setw( 12 )
+        << this->_peakResourceTotal << "\n";
+    out.unsetf( std::ios_base::floatfield );
+  }  // Instrumentation::WriteSummary
+
+  void Instrumentation::WriteJson( std::ostream &out ) const
+  {
+    // cursor kind spellings and resource names are plain text without quotes or backslashes.
+    out << std::fixed << std::setprecision( 3 );
+    out << "{\"phases\":{";
+    for ( std::size_t i = 0; i < numberOfPhases; ++i ) {
+      out << ( ( i == 0 ) ? "\"" : ",\"" ) << phaseKeys[i] << "\":{\"calls\":"
+          << this->_phases[i]._calls << ",\"ms\":" << milliseconds( this->_phases[i]._time )
+          << "}";
+    }
+    out << "},\"cursors\":{";
+    bool isFirst = true;
+    for ( const auto &cursor : this->_cursors ) {
+      out << ( isFirst ? "\"" : ",\"" ) << cursorKindName( cursor.first ) << "\":" << cursor.second;
+      isFirst = false;
+    }
+    out << "},\"transitions\":{";
+    for ( std::size_t i = 0; i < numberOfStates; ++i ) {
+      out << ( ( i == 0 ) ? "\"" : ",\"" ) << stateNames[i] << "\":" << this->_transitions[i];
+    }
+    out << "},\"rollbacks\":" << this->_rollbacks << ",\"fast_path\":{\"taken\":"
+        << this->_fastPathTaken << ",\"fallbacks\":" << this->_fastPathFallbacks << "}"
+        << ",\"translation_units\":" << this->_translationUnits << ",\"memory\":{";
+    isFirst = true;
+    for ( const auto &resource : this->_resources ) {
+      out << ( isFirst ? "\"" : ",\"" ) << resource.first << "\":" << resource.second;
+      isFirst = false;
+    }
+    out << "},\"memory_total\":" << this->_peakResourceTotal << "}\n";
+    out.unsetf( std::ios_base::floatfield );
+  }  // Instrumentation::WriteJson
+}  // namespace RomanoViolet
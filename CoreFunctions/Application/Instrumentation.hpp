@@ -0,0 +1,98 @@
+#ifndef _INSTRUMENTATION_HPP_
+#define _INSTRUMENTATION_HPP_
+
+#include "StateMachine.hpp"
+#include <array>
+#include <chrono>
+#include <clang-c/Index.h>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <string>
+namespace RomanoViolet
+{
+  /**
+   * @brief Wall time per phase of the parser pipeline, and counters of what the traversal and the
+   * state machine did.
+   * @details Recording is not synchronized: every extraction records into an instance of its own,
+   * which is then merged into a shared one with Merge, which is safe to call from several threads.
+   */
+  class Instrumentation
+  {
+  public:
+    enum class Phase : short {
+      INDEX_CREATION,  ///< clang_createIndex
+      PARSE,           ///< clang_parseTranslationUnit, once per pass.
+      TRAVERSAL,       ///< clang_visitChildren, including the state machine.
+      PRINTING,        ///< Writing the results in the requested format.
+    };
+
+    /**
+     * @brief Adds the time from construction to destruction to phase. Does nothing if
+     * instrumentation is nullptr, so that call sites need not check whether timing is requested.
+     */
+    class Timer
+    {
+    public:
+      Timer( Instrumentation *instrumentation, Phase phase );
+      ~Timer( );
+      Timer( const Timer & ) = delete;
+      Timer &operator=( const Timer & ) = delete;
+
+    private:
+      Instrumentation *const _instrumentation;
+      const Phase _phase;
+      const std::chrono::steady_clock::time_point _start;
+    };
+
+    Instrumentation( );
+    Instrumentation( const Instrumentation & ) = delete;
+    Instrumentation &operator=( const Instrumentation & ) = delete;
+
+    void AddTime( Phase phase, std::chrono::steady_clock::duration duration );
+    void CountCursor( CXCursorKind kind );
+    // A step of the state machine which changed its state to state.
+    void CountTransition( StateMachine::State state );
+    // A step of the state machine which went back to INIT, since the cursor did not belong to the
+    // class being sought.
+    void CountRollback( );
+    // A header given to the token-level fast path, see TokenScanner. isTaken is false if the
+    // header fell back to the regular extraction.
+    void CountFastPath( bool isTaken );
+    // Memory held by libclang for tu, see clang_getCXTUResourceUsage. Peaks are kept per kind.
+    void RecordResourceUsage( CXTranslationUnit tu );
+
+    // Adds everything recorded by other. Thread-safe.
+    void Merge( const Instrumentation &other );
+
+    // Human readable summary.
+    void WriteSummary( std::ostream &out ) const;
+    // The same as a single JSON object, terminated by a newline.
+    void WriteJson( std::ostream &out ) const;
+
+  private:
+    static constexpr std::size_t numberOfPhases = static_cast< std::size_t >( Phase::PRINTING ) + 1;
+    static constexpr std::size_t numberOfStates
+        = static_cast< std::size_t >( StateMachine::State::IDLE_AFTER_IODIRECTIONCOLLECTION ) + 1;
+
+    struct PhaseTime {
+      std::size_t _calls = 0;
+      std::chrono::steady_clock::duration _time = std::chrono::steady_clock::duration::zero( );
+    };
+
+    std::array< PhaseTime, numberOfPhases > _phases;
+    // keyed by CXCursorKind; ordered, so that reports are stable.
+    std::map< int, std::size_t > _cursors;
+    std::array< std::size_t, numberOfStates > _transitions;
+    std::size_t _rollbacks;
+    std::size_t _fastPathTaken;
+    std::size_t _fastPathFallbacks;
+    // peak bytes per resource kind, and peak total, over all translation units.
+    std::map< std::string, unsigned long > _resources;
+    unsigned long _peakResourceTotal;
+    std::size_t _translationUnits;
+
+    std::mutex _mergeMutex;
+  };  // class Instrumentation
+}  // namespace RomanoViolet
+#endif  // !_INSTRUMENTATION_HPP_
@@ -11,12 +11,25 @@
  * repository.
  */
 
+#include "BatchMode.hpp"
+#include "CursorLog.hpp"
+#include "Instrumentation.hpp"
+#include "ResultCache.hpp"
+#include "ResultSink.hpp"
+#include "SharedPreamble.hpp"
 #include "StateMachine.hpp"
+#include "TokenScanner.hpp"
+#include "WatchMode.hpp"
 #include <cassert>
+#include <cerrno>
 #include <clang-c/Index.h>
+#include <climits>
 #include <cstdlib>
+#include <iterator>
+#include <memory>
 #include <iostream>
 #include <string>
+#include <sys/stat.h>
 #include <utility>
 #include <vector>
 using LineColumn = std::pair< unsigned, unsigned >;
@@ -34,8 +47,12 @@ struct ClassDetails {
 };
 
 struct Data {
+  // Spellings taken from libclang, see namespacesOf( ).
+  RomanoViolet::StringPool _strings;
+  // Scratch space of namespacesOf( ), which keeps its capacity from one cursor to the next.
+  std::string _buffer;
   CXCursorKind _cursorKind;
-  std::string _tranlationUnitName;
+  RomanoViolet::StringRef _tranlationUnitName;
   ClassDetails _classDetails;
   std::vector< IODetails > io;
   std::string _temp;
@@ -43,13 +60,39 @@ struct Data {
   bool insideClass = false;
   bool insideIODeclaration = false;
   RomanoViolet::StateMachine *p;
+
+  // Traversal pruning, see visit( ).
+  bool prune = true;
+  bool allClasses = false;
+  // Qualified namespace of the class to inspect, e.g., "NN::RomanoViolet". Empty if not known.
+  std::string _namespaceToInspect;
+  std::size_t visitedCursors = 0;
+  // Counts the visited cursors by kind, if not nullptr.
+  RomanoViolet::Instrumentation *instrumentation = nullptr;
+  // Records the cursors fed to the state machine, if not nullptr.
+  RomanoViolet::CursorRecorder *recorder = nullptr;
 };
 
-std::string toString( CXString cxString )
+// The namespace cursor and the namespaces enclosing it, outermost first, e.g., "NN::RomanoViolet"
+// for RomanoViolet. Empty if cursor is not a namespace. Interned into data._strings, as the state
+// machine does with spellings: for namespaces seen before, nothing is allocated besides the
+// spellings libclang hands out.
+RomanoViolet::StringRef namespacesOf( CXCursor cursor, Data &data )
+{
+  data._buffer.clear( );
+  for ( bool isInnermost = true; clang_getCursorKind( cursor ) == CXCursorKind::CXCursor_Namespace;
+        cursor = clang_getCursorSemanticParent( cursor ), isInnermost = false ) {
+    const RomanoViolet::StringRef name = data._strings.Intern( clang_getCursorSpelling( cursor ) );
+    data._buffer.insert( 0, isInnermost ? "" : "::" );
+    data._buffer.insert( 0, name.data( ), name.size( ) );
+  }
+  return data._strings.Intern( RomanoViolet::StringRef( data._buffer ) );
+}
+
+// Namespaces enclosing cursor, outermost first, e.g., "NN::RomanoViolet".
+RomanoViolet::StringRef enclosingNamespaces( CXCursor cursor, Data &data )
 {
-  std::string string = clang_getCString( cxString );
-  clang_disposeString( cxString );
-  return string;
+  return namespacesOf( clang_getCursorSemanticParent( cursor ), data );
 }
 
 CXChildVisitResult visitForFirstPass( CXCursor cursor, CXCursor parent, CXClientData clientData )
@@ -62,14 +105,15 @@ CXChildVisitResult visitForFirstPass( CXCursor cursor, CXCursor parent, CXClient
   const CXCursorKind kind = clang_getCursorKind( cursor );
   // CXString name = clang_getCursorSpelling( cursor );
   Data *data = static_cast< Data * >( clientData );
+  if ( data->instrumentation != nullptr ) {
+    data->instrumentation->CountCursor( kind );
+  }
 
   // collect all successive namespaces
   if ( kind == CXCursorKind ::CXCursor_Namespace ) {
-    if ( data->_temp.empty( ) ) {
-      data->_temp = toString( clang_getCursorSpelling( cursor ) );
-    } else {
-      data->_temp.append( "::" + toString( clang_getCursorSpelling( cursor ) ) );
-    }
+    const RomanoViolet::StringRef name = data->_strings.Intern( clang_getCursorSpelling( cursor ) );
+    data->_temp.append( data->_temp.empty( ) ? "" : "::" );
+    data->_temp.append( name.data( ), name.size( ) );
   }
 
   // in order to bot collect all possible non-consecutive namespaces, clear the variable
@@ -83,7 +127,11 @@ CXChildVisitResult visitForFirstPass( CXCursor cursor, CXCursor parent, CXClient
     case CXCursorKind ::CXCursor_ClassDecl: {
       // AST hierarchy for top level class: Namespace - Class - Baseclass.
       data->_classDetails._namespace = data->_temp;
-      data->_classDetails._name = toString( clang_getCursorSpelling( cursor ) );
+      const RomanoViolet::StringRef name
+          = data->_strings.Intern( clang_getCursorSpelling( cursor ) );
+      data->_classDetails._name.assign( name.data( ), name.size( ) );
+      const RomanoViolet::StringRef namespaces = enclosingNamespaces( cursor, *data );
+      data->_namespaceToInspect.assign( namespaces.data( ), namespaces.size( ) );
       // data->_classDetails._namespace.append( "::" + toString( clang_getCursorSpelling( parent ) )
       // );
 
@@ -99,25 +147,141 @@ CXChildVisitResult visitForFirstPass( CXCursor cursor, CXCursor parent, CXClient
   return result;
 }  // visitForFirstPass
 
+// Feeds cursor to the state machine, recording it on the way if requested.
+void advance( Data *data, CXCursor cursor )
+{
+  if ( data->recorder != nullptr ) {
+    data->recorder->Record( cursor );
+  }
+  data->p->AdvanceStateMachine( cursor );
+}
+
 CXChildVisitResult visit( CXCursor cursor, CXCursor parent, CXClientData clientData )
 {
   // CXString name = clang_getCursorSpelling( cursor );
   ( void )parent;
   Data *data = static_cast< Data * >( clientData );
-  data->p->AdvanceStateMachine( cursor );
+  ++data->visitedCursors;
+  if ( data->instrumentation != nullptr ) {
+    data->instrumentation->CountCursor( clang_getCursorKind( cursor ) );
+  }
+
+  if ( !data->prune ) {
+    advance( data, cursor );
+    return CXChildVisit_Recurse;
+  }
+
+  // The classes of interest are defined in the header itself. Subtrees from included headers,
+  // system headers and the SafeType machinery among them, are skipped as a whole.
+  if ( !clang_Location_isFromMainFile( clang_getCursorLocation( cursor ) ) ) {
+    return CXChildVisit_Continue;
+  }
+
+  // So are namespaces which cannot contain the class, if its namespace is known.
+  const CXCursorKind kind = clang_getCursorKind( cursor );
+  if ( ( kind == CXCursorKind::CXCursor_Namespace ) && !data->_namespaceToInspect.empty( ) ) {
+    const RomanoViolet::StringRef name = namespacesOf( cursor, *data );
+    const std::string &inspected = data->_namespaceToInspect;
+    const bool isEnclosing
+        = ( inspected.compare( 0, name.size( ), name.data( ), name.size( ) ) == 0 )
+          && ( ( inspected.size( ) == name.size( ) )
+               || ( inspected.compare( name.size( ), 2, "::" ) == 0 ) );
+    if ( !isEnclosing ) {
+      return CXChildVisit_Continue;
+    }
+  }
+
+  advance( data, cursor );
+
+  if ( kind == CXCursorKind::CXCursor_ClassDecl ) {
+    if ( !clang_isCursorDefinition( cursor ) || !data->p->IsInspectingClass( ) ) {
+      return CXChildVisit_Continue;
+    }
+    // Once the subtree of the class is done, so is the class. Unless all classes are inspected,
+    // nothing of interest remains.
+    clang_visitChildren( cursor, visit, clientData );
+    return data->allClasses ? CXChildVisit_Continue : CXChildVisit_Break;
+  }
 
-  // clang visitor should visit the next sibling of this cursor without visiting the children.
   return CXChildVisit_Recurse;
 }  // visit
 
+// The offset of location in its file.
+unsigned offsetOf( CXSourceLocation location )
+{
+  unsigned offset = 0;
+  clang_getFileLocation( location, nullptr, nullptr, nullptr, &offset );
+  return offset;
+}
+
+// The declaration among the children of the translation unit which holds cursor, or a null cursor
+// if cursor is not a declaration.
+CXCursor topLevelDeclarationOf( CXCursor cursor )
+{
+  if ( !clang_isDeclaration( clang_getCursorKind( cursor ) ) ) {
+    return clang_getNullCursor( );
+  }
+  for ( CXCursor parent = clang_getCursorLexicalParent( cursor ); !clang_Cursor_isNull( parent );
+        cursor = parent, parent = clang_getCursorLexicalParent( parent ) ) {
+    if ( clang_getCursorKind( parent ) == CXCursorKind::CXCursor_TranslationUnit ) {
+      return cursor;
+    }
+  }
+  return clang_getNullCursor( );
+}
+
+// Visits the declarations at the top level of the main file, in order, as visit( ) would be called
+// for them by clang_visitChildren on the translation unit. They are found from the tokens of the
+// main file instead of among the top-level cursors of the whole include closure, all of which
+// visit( ) would only skip: the first token in each declaration is looked up with clang_getCursor,
+// and the tokens of the declaration are skipped once it is visited. Macro definitions and
+// expansions, which the state machine ignores, are not visited.
+void traverseMainFile( CXTranslationUnit tu, CXCursor root, Data &data )
+{
+  // the extent of the translation unit is the main file.
+  CXToken *tokens = nullptr;
+  unsigned numberOfTokens = 0;
+  clang_tokenize( tu, clang_getCursorExtent( root ), &tokens, &numberOfTokens );
+  unsigned endOfDeclaration = 0;
+  bool isBroken = false;
+  for ( unsigned i = 0; ( i < numberOfTokens ) && !isBroken; ++i ) {
+    const CXSourceLocation location = clang_getTokenLocation( tu, tokens[i] );
+    if ( ( i != 0 ) && ( offsetOf( location ) < endOfDeclaration ) ) {
+      continue;
+    }
+    const CXCursor declaration = topLevelDeclarationOf( clang_getCursor( tu, location ) );
+    if ( clang_Cursor_isNull( declaration ) ) {
+      continue;
+    }
+    endOfDeclaration = offsetOf( clang_getRangeEnd( clang_getCursorExtent( declaration ) ) );
+    switch ( visit( declaration, root, &data ) ) {
+      case CXChildVisit_Break:
+        isBroken = true;
+        break;
+      case CXChildVisit_Recurse:
+        // nonzero if a visit below ended the traversal.
+        isBroken = ( clang_visitChildren( declaration, visit, &data ) != 0 );
+        break;
+      default:
+        break;
+    }
+  }
+  clang_disposeTokens( tu, tokens, numberOfTokens );
+}  // traverseMainFile
+
 void traverse( CXTranslationUnit tu, Data &data )
 {
   CXCursor root = clang_getTranslationUnitCursor( tu );
 
   // name of this translation unit
-  data._tranlationUnitName = toString( clang_getTranslationUnitSpelling( tu ) );
+  data._tranlationUnitName = data._strings.Intern( clang_getTranslationUnitSpelling( tu ) );
 
-  clang_visitChildren( root, visit, &data );
+  // pruned, the traversal has no use for the top-level cursors of the included headers.
+  if ( data.prune ) {
+    traverseMainFile( tu, root, data );
+  } else {
+    clang_visitChildren( root, visit, &data );
+  }
 }
 
 void traverseForFirstPass( CXTranslationUnit tu, Data &data )
@@ -125,76 +289,575 @@ void traverseForFirstPass( CXTranslationUnit tu, Data &data )
   CXCursor root = clang_getTranslationUnitCursor( tu );
 
   // name of this translation unit
-  data._tranlationUnitName = toString( clang_getTranslationUnitSpelling( tu ) );
+  data._tranlationUnitName = data._strings.Intern( clang_getTranslationUnitSpelling( tu ) );
 
   clang_visitChildren( root, visitForFirstPass, &data );
 }
 
-auto main( int argc, const char *argv[] ) -> int
+constexpr const char *defaultArguments[] = {
+    "-x", "c++", "-std=c++11", "-Xclang", "-fsyntax-only", "-I/workspaces/LLVM/CoreFunctions" };
+
+// Added by the lean parse profile: the extraction has no use for warnings, nor for the typo
+// corrections looked for on every name which does not resolve.
+constexpr const char *leanArguments[] = { "-w", "-fno-spell-checking" };
+
+// Command line options understood by the parser.
+struct Options {
+  // Discover the class and extract its IO in a single parse of the header.
+  bool singlePass = false;
+  // Precompile the includes shared by all headers once, and reuse them for every header.
+  bool sharedPreamble = false;
+  const RomanoViolet::SharedPreamble *preamble = nullptr;
+  // Directory of the persistent result cache. Empty if no cache is to be used.
+  std::string cacheDirectory;
+  RomanoViolet::ResultCache *cache = nullptr;
+  // Extract every class defined in the header instead of only the first one.
+  bool allClasses = false;
+  // Feed every cursor of the translation unit to the state machine, see visit( ).
+  bool fullTraversal = false;
+  // Extract from the tokens of the header alone where possible, see extractFromTokens( ). Ignored
+  // with fullTraversal, when recording cursors, and in watch mode.
+  bool fast = false;
+  // Parse profile "lean" instead of "full": see extractionFlags( ) and leanArguments.
+  bool leanProfile = false;
+  // Directory of stub headers searched before the sources, e.g.,
+  // CoreFunctions/Application/StubHeaders. Empty if not requested.
+  std::string stubIncludes;
+  // The arguments every parse is made with, see makeArguments( ).
+  std::vector< std::string > arguments;
+  // Report the number of cursors visited per header on std::cerr.
+  bool stats = false;
+  // Report per-phase timings and counters on std::cerr once all headers are done, see
+  // Instrumentation. Empty if not requested, otherwise "text" or "json".
+  std::string profile;
+  RomanoViolet::Instrumentation *instrumentation = nullptr;
+  // File the cursors fed to the state machine are recorded into, see CursorLog.hpp. Empty if not
+  // requested.
+  std::string cursorLogFile;
+  RomanoViolet::CursorLogWriter *cursorLog = nullptr;
+  RomanoViolet::OutputFormat format = RomanoViolet::OutputFormat::TEXT;
+  // Whether the output of every header is labelled with the header, see MakeResultSink. Set
+  // when the headers are given as a set, i.e., by several arguments, a directory or --list, or in
+  // watch mode, however many headers the set holds.
+  bool labelHeaders = false;
+  // Keep the translation units resident, and reparse them whenever a file they depend on changes.
+  bool watch = false;
+  // Number of batch workers. 0 selects one worker per hardware thread.
+  unsigned jobs = 0;
+  std::vector< std::string > headers;
+};
+
+// Reads text, a positive decimal number, into jobs. false for anything else, e.g., "0", "-1",
+// "4x" or a number beyond unsigned.
+bool parseJobs( const char *text, unsigned &jobs )
+{
+  if ( ( *text < '0' ) || ( *text > '9' ) ) {
+    return false;
+  }
+  char *end = nullptr;
+  errno = 0;
+  const unsigned long value = std::strtoul( text, &end, 10 );
+  if ( ( *end != '\0' ) || ( errno == ERANGE ) || ( value == 0 ) || ( value > UINT_MAX ) ) {
+    return false;
+  }
+  jobs = static_cast< unsigned >( value );
+  return true;
+}  // parseJobs
+
+bool isDirectory( const std::string &path )
+{
+  struct stat status;
+  return ( stat( path.c_str( ), &status ) == 0 ) && S_ISDIR( status.st_mode );
+}
+
+bool parseOptions( int argc, const char *argv[], Options &options )
+{
+  std::size_t numberOfHeaderArguments = 0;
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( argument.compare( "--single-pass" ) == 0 ) {
+      options.singlePass = true;
+    } else if ( argument.compare( "--all-classes" ) == 0 ) {
+      options.allClasses = true;
+    } else if ( argument.compare( "--full-traversal" ) == 0 ) {
+      options.fullTraversal = true;
+    } else if ( argument.compare( "--fast" ) == 0 ) {
+      options.fast = true;
+    } else if ( argument.compare( "--stats" ) == 0 ) {
+      options.stats = true;
+    } else if ( argument.compare( "--watch" ) == 0 ) {
+      options.watch = true;
+    } else if ( argument.compare( "--shared-preamble" ) == 0 ) {
+      options.sharedPreamble = true;
+    } else if ( ( argument.compare( "--cache" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.cacheDirectory = argv[++i];
+    } else if ( ( argument.compare( "--parse-profile" ) == 0 ) && ( i + 1 < argc ) ) {
+      const std::string profile = argv[++i];
+      if ( ( profile.compare( "full" ) != 0 ) && ( profile.compare( "lean" ) != 0 ) ) {
+        std::cerr << "Unknown parse profile: " << profile << "\n";
+        return false;
+      }
+      options.leanProfile = ( profile.compare( "lean" ) == 0 );
+    } else if ( ( argument.compare( "--stub-includes" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.stubIncludes = argv[++i];
+    } else if ( ( argument.compare( "--record" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.cursorLogFile = argv[++i];
+    } else if ( ( argument.compare( "--profile" ) == 0 ) && ( i + 1 < argc ) ) {
+      options.profile = argv[++i];
+      if ( ( options.profile.compare( "text" ) != 0 ) && ( options.profile.compare( "json" ) != 0 ) ) {
+        std::cerr << "Unknown profile format: " << options.profile << "\n";
+        return false;
+      }
+    } else if ( ( argument.compare( "--format" ) == 0 ) && ( i + 1 < argc ) ) {
+      if ( !RomanoViolet::ParseOutputFormat( argv[++i], options.format ) ) {
+        std::cerr << "Unknown output format: " << argv[i] << "\n";
+        return false;
+      }
+    } else if ( ( argument.compare( "--jobs" ) == 0 ) && ( i + 1 < argc ) ) {
+      if ( !parseJobs( argv[++i], options.jobs ) ) {
+        std::cerr << "Invalid number of jobs: " << argv[i] << "\n";
+        return false;
+      }
+    } else if ( ( argument.compare( "--list" ) == 0 ) && ( i + 1 < argc ) ) {
+      if ( !RomanoViolet::CollectHeadersFromList( argv[++i], options.headers ) ) {
+        std::cerr << "Unable to read header list: " << argv[i] << "\n";
+        return false;
+      }
+      options.labelHeaders = true;
+    } else if ( argument.compare( 0, 2, "--" ) != 0 ) {
+      if ( !RomanoViolet::CollectHeaders( argument, options.headers ) ) {
+        std::cerr << "No such header or directory: " << argument << "\n";
+        return false;
+      }
+      ++numberOfHeaderArguments;
+      options.labelHeaders = options.labelHeaders || isDirectory( argument );
+    } else {
+      std::cerr << "Unknown argument: " << argument << "\n";
+      return false;
+    }
+  }
+  options.labelHeaders
+      = options.labelHeaders || options.watch || ( numberOfHeaderArguments > 1 );
+  return !options.headers.empty( );
+}
+
+// The default arguments, with the stub headers, if any, searched before any other include
+// directory, and the ones of the lean profile if selected.
+std::vector< std::string > makeArguments( const Options &options )
+{
+  std::vector< std::string > arguments;
+  bool isStubDirectoryAdded = options.stubIncludes.empty( );
+  for ( const char *argument : defaultArguments ) {
+    if ( !isStubDirectoryAdded && ( std::string( argument ).compare( 0, 2, "-I" ) == 0 ) ) {
+      arguments.emplace_back( "-I" + options.stubIncludes );
+      isStubDirectoryAdded = true;
+    }
+    arguments.emplace_back( argument );
+  }
+  if ( !isStubDirectoryAdded ) {
+    arguments.emplace_back( "-I" + options.stubIncludes );
+  }
+  if ( options.leanProfile ) {
+    arguments.insert( arguments.end( ), std::begin( leanArguments ), std::end( leanArguments ) );
+  }
+  return arguments;
+}  // makeArguments
+
+// Views options.arguments as the command line libclang expects.
+std::vector< const char * > commandLineOf( const Options &options )
+{
+  std::vector< const char * > commandLine;
+  for ( const std::string &argument : options.arguments ) {
+    commandLine.emplace_back( argument.c_str( ) );
+  }
+  return commandLine;
+}
+
+// Flags of the extraction parse under the parse profile of options. The full profile keeps the
+// detailed preprocessing record, i.e., macro definitions and expansions as cursors, which the
+// state machine skips anyway; the lean one does not build it.
+unsigned extractionFlags( const Options &options )
+{
+  const unsigned flags
+      = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
+        | CXTranslationUnit_Flags::CXTranslationUnit_IgnoreNonErrorsFromIncludedFiles
+        | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete;
+  return options.leanProfile
+             ? flags
+             : ( flags | CXTranslationUnit_Flags::CXTranslationUnit_DetailedPreprocessingRecord );
+}
+
+// Parses header for the state machine. extraFlags are added to the default parse options.
+CXTranslationUnit parseForExtraction( CXIndex index,
+                                      const char *header,
+                                      const Options &options,
+                                      unsigned extraFlags )
+{
+  // the shared includes, if precompiled, are loaded from the PCH instead of being parsed again,
+  // unless header includes others than the PCH holds.
+  std::vector< const char * > arguments = commandLineOf( options );
+  if ( ( options.preamble != nullptr ) && options.preamble->IsUsableFor( header ) ) {
+    options.preamble->AddArguments( arguments );
+  }
+
+  const unsigned flags = extractionFlags( options ) | extraFlags;
+
+  return clang_parseTranslationUnit( index,
+                                     /*source_filename=*/header,
+                                     /*command_line_args=*/arguments.data( ),
+                                     /*num_command_line_args=*/arguments.size( ),
+                                     /*unsaved_files=*/nullptr,
+                                     /*num_unsaved_files=*/0,
+                                     /*options=*/flags );
+}
+
+// Writes the classes extracted from header to out in the requested format.
+void writeResults( const char *header,
+                   const std::vector< RomanoViolet::StateMachine::ClassDetails > &inspectedClasses,
+                   const Options &options,
+                   std::ostream &out )
 {
-  ( void )argc;
-  CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
-                                     /*displayDiagnostics=*/true );
+  RomanoViolet::BufferedWriter writer( out );
+  const std::unique_ptr< RomanoViolet::ResultSink > sink
+      = RomanoViolet::MakeResultSink( options.format, writer, options.labelHeaders );
+  sink->BeginHeader( header );
+  for ( const RomanoViolet::StateMachine::ClassDetails &classDetails : inspectedClasses ) {
+    sink->WriteClass( header, classDetails );
+  }
+}
+
+// Runs the state machine over tu, the parse of header, and prints the summary to out.
+// An empty classToInspect puts the state machine into discovery mode. namespaceToInspect may be
+// empty if not known. Records into instrumentation, if not nullptr.
+void extractFromTranslationUnit( CXTranslationUnit tu,
+                                 const char *header,
+                                 const std::string &classToInspect,
+                                 const std::string &namespaceToInspect,
+                                 const Options &options,
+                                 RomanoViolet::Instrumentation *instrumentation,
+                                 std::ostream &out )
+{
+  using Phase = RomanoViolet::Instrumentation::Phase;
+  Data data;
+  RomanoViolet::StateMachine p{ classToInspect, options.allClasses };
+  p.SetInstrumentation( instrumentation );
+  data.p = &p;
+  data.prune = !options.fullTraversal;
+  data.allClasses = options.allClasses;
+  data._namespaceToInspect = namespaceToInspect;
+  data.instrumentation = instrumentation;
+  std::unique_ptr< RomanoViolet::CursorRecorder > recorder;
+  if ( options.cursorLog != nullptr ) {
+    recorder.reset(
+        new RomanoViolet::CursorRecorder( header, classToInspect, options.allClasses ) );
+    data.recorder = recorder.get( );
+  }
+  {
+    RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::TRAVERSAL );
+    traverse( tu, data );
+  }
+  if ( recorder ) {
+    options.cursorLog->Append( *recorder );
+  }
+  if ( instrumentation != nullptr ) {
+    instrumentation->RecordResourceUsage( tu );
+  }
+  if ( options.stats ) {
+    std::cerr << "Visited cursors: " << data.visitedCursors << " (" << header << ")\n";
+  }
+  const std::vector< RomanoViolet::StateMachine::ClassDetails > inspectedClasses
+      = p.GetInspectedClasses( );
+  if ( options.cache != nullptr ) {
+    options.cache->Store( header, tu, inspectedClasses );
+  }
+  RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::PRINTING );
+  writeResults( header, inspectedClasses, options, out );
+}
+
+// Extracts the IO from the tokens of tu, a parse of header alone, and prints the summary to out as
+// the regular extraction would, see RomanoViolet::TokenScanner. Returns false, having printed
+// nothing, if the header leaves the layout the scan understands; it is then to be extracted as
+// usual. Records into instrumentation, if not nullptr.
+bool extractFromTokens( CXTranslationUnit tu,
+                        const char *header,
+                        const Options &options,
+                        RomanoViolet::Instrumentation *instrumentation,
+                        std::ostream &out )
+{
+  using Phase = RomanoViolet::Instrumentation::Phase;
+  RomanoViolet::TokenScanner scanner( tu );
+  bool isScanned;
+  {
+    RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::TRAVERSAL );
+    isScanned = scanner.Scan( options.allClasses );
+  }
+  if ( instrumentation != nullptr ) {
+    instrumentation->CountFastPath( isScanned );
+  }
+  if ( !isScanned ) {
+    if ( options.stats ) {
+      std::cerr << "Fast path fell back at line " << scanner.GetLineOfFailure( ) << " (" << header
+                << ")\n";
+    }
+    return false;
+  }
+
+  // The state machine is set up as in extractHeader( ): unless the class is discovered, the one
+  // the first pass would have found is looked for, and only its namespaces are entered.
+  const bool isDiscovered = options.singlePass || options.allClasses;
+  const std::string classToInspect = isDiscovered ? "" : scanner.GetFirstClass( ).str( );
+  const std::string namespaceToInspect
+      = isDiscovered ? "" : scanner.GetFirstClassNamespaces( ).str( );
+  RomanoViolet::StateMachine p{ classToInspect, options.allClasses };
+  p.SetInstrumentation( instrumentation );
+  {
+    RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::TRAVERSAL );
+    scanner.Feed( p, namespaceToInspect, options.allClasses );
+  }
+  if ( options.stats ) {
+    std::cerr << "Scanned tokens: " << scanner.GetNumberOfTokens( ) << " (" << header << ")\n";
+  }
+  const std::vector< RomanoViolet::StateMachine::ClassDetails > inspectedClasses
+      = p.GetInspectedClasses( );
+  if ( options.cache != nullptr ) {
+    options.cache->Store( header, tu, inspectedClasses );
+  }
+  RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::PRINTING );
+  writeResults( header, inspectedClasses, options, out );
+  return true;
+}
+
+// Extracts the IO of the class declared in header, and prints the summary to out. Records into
+// instrumentation, if not nullptr.
+void extractHeader( CXIndex index,
+                    const char *header,
+                    const Options &options,
+                    RomanoViolet::Instrumentation *instrumentation,
+                    std::ostream &out )
+{
+  using Phase = RomanoViolet::Instrumentation::Phase;
+
+  // A cache hit skips libclang altogether.
+  if ( options.cache != nullptr ) {
+    RomanoViolet::StringPool strings;
+    std::vector< RomanoViolet::StateMachine::ClassDetails > cached;
+    if ( options.cache->Lookup( header, strings, cached ) ) {
+      RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::PRINTING );
+      writeResults( header, cached, options, out );
+      return;
+    }
+  }
 
   // See https://clang.llvm.org/doxygen/group__CINDEX__TRANSLATION__UNIT.html
   // for the possible options (last argument).
 
-  unsigned flags = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
-                   | CXTranslationUnit_Flags::CXTranslationUnit_IgnoreNonErrorsFromIncludedFiles
-                   | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete
-                   | CXTranslationUnit_Flags::CXTranslationUnit_SingleFileParse;
+  const unsigned flags = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
+                         | CXTranslationUnit_Flags::CXTranslationUnit_IgnoreNonErrorsFromIncludedFiles
+                         | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete
+                         | CXTranslationUnit_Flags::CXTranslationUnit_SingleFileParse;
 
-  constexpr const char *defaultArguments[] = {
-      "-x", "c++", "-std=c++11", "-Xclang", "-fsyntax-only", "-I/workspaces/LLVM/CoreFunctions" };
-
-  // Application-scope data storage
+  // Header-scope data storage
   Data data;
+  CXTranslationUnit tu;
 
   // First Pass to get class-level information out.
   // The objective of the first pass is to find out the class declared in the test file
   // "Component.hpp" and pass it to the second parse stage.
-  // If the exact class name is known before-hand, the first stage may be removed.
+  // In single-pass mode, the class is instead discovered by the state machine while it walks the
+  // one and only parse, and the first stage is skipped altogether.
+  // With all classes inspected, there is no single class to look for in the first place.
+  // The fast path needs the parse of the header alone as well, and uses the one of the first pass
+  // if there is one. If it falls back, the extraction continues as if it had not been tried.
+  const bool isFirstPassNeeded = !options.singlePass && !options.allClasses;
+  const bool isFastPathUsable
+      = options.fast && !options.fullTraversal && ( options.cursorLog == nullptr );
+  if ( isFirstPassNeeded || isFastPathUsable ) {
+    {
+      const std::vector< const char * > arguments = commandLineOf( options );
+      RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::PARSE );
+      tu = clang_parseTranslationUnit( index,
+                                       /*source_filename=*/header,
+                                       /*command_line_args=*/arguments.data( ),
+                                       /*num_command_line_args=*/arguments.size( ),
+                                       /*unsaved_files=*/nullptr,
+                                       /*num_unsaved_files=*/0,
+                                       /*options=*/flags );
+    }
+
+    if ( tu == nullptr ) {
+      std::cerr << "Unable to parse translation unit. Quitting.\n";
+    } else {
+      const bool isExtracted
+          = isFastPathUsable && extractFromTokens( tu, header, options, instrumentation, out );
+      if ( !isExtracted && isFirstPassNeeded ) {
+        data.instrumentation = instrumentation;
+        RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::TRAVERSAL );
+        traverseForFirstPass( tu, data );
+      }
+      if ( instrumentation != nullptr ) {
+        instrumentation->RecordResourceUsage( tu );
+      }
+      clang_disposeTranslationUnit( tu );
+      if ( isExtracted ) {
+        return;
+      }
+    }
+  }
 
-  CXTranslationUnit tu = clang_parseTranslationUnit( index,
-                                                     /*source_filename=*/argv[1],
-                                                     /*command_line_args=*/defaultArguments,
-                                                     /*num_command_line_args=*/6,
-                                                     /*unsaved_files=*/nullptr,
-                                                     /*num_unsaved_files=*/0,
-                                                     /*options=*/flags );
+  // Second Pass: Aggregate required details of the requested class.
+  {
+    RomanoViolet::Instrumentation::Timer timer( instrumentation, Phase::PARSE );
+    tu = parseForExtraction( index, header, options, /*extraFlags=*/0 );
+  }
 
   if ( tu == nullptr ) {
     std::cerr << "Unable to parse translation unit. Quitting.\n";
   } else {
-    traverseForFirstPass( tu, data );
+    extractFromTranslationUnit( tu,
+                                header,
+                                data._classDetails._name,
+                                data._namespaceToInspect,
+                                options,
+                                instrumentation,
+                                out );
     clang_disposeTranslationUnit( tu );
   }
-  clang_disposeIndex( index );
+}
 
-  // Second Pass: Aggregate required details of the requested class.
-  RomanoViolet::StateMachine p{ data._classDetails._name };
-  index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
-                             /*displayDiagnostics=*/true );
-  flags = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
-          | CXTranslationUnit_Flags::CXTranslationUnit_IgnoreNonErrorsFromIncludedFiles
-          | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete
-          | CXTranslationUnit_Flags::CXTranslationUnit_DetailedPreprocessingRecord;
-
-  tu = clang_parseTranslationUnit( index,
-                                   /*source_filename=*/argv[1],
-                                   /*command_line_args=*/defaultArguments,
-                                   /*num_command_line_args=*/6,
-                                   /*unsaved_files=*/nullptr,
-                                   /*num_unsaved_files=*/0,
-                                   /*options=*/flags );
+// As above, recording into options.instrumentation if requested. Safe to call from batch workers:
+// each extraction records on its own, and is merged once done.
+void extractHeader( CXIndex index, const char *header, const Options &options, std::ostream &out )
+{
+  if ( options.instrumentation == nullptr ) {
+    extractHeader( index, header, options, nullptr, out );
+    return;
+  }
+  RomanoViolet::Instrumentation instrumentation;
+  extractHeader( index, header, options, &instrumentation, out );
+  options.instrumentation->Merge( instrumentation );
+}
 
-  if ( tu == nullptr ) {
-    std::cerr << "Unable to parse translation unit. Quitting.\n";
+auto main( int argc, const char *argv[] ) -> int
+{
+  Options options;
+  if ( !parseOptions( argc, argv, options ) ) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--single-pass] [--all-classes] [--shared-preamble] [--cache <directory>]"
+                 " [--jobs <n>] [--list <file>] [--full-traversal] [--fast] [--parse-profile <full|lean>]"
+                 " [--stub-includes <directory>] [--stats]"
+                 " [--profile <text|json>] [--record <file>] [--format <text|jsonl|binary>]"
+                 " [--watch]"
+                 " <header|directory>...\n";
+    return EXIT_FAILURE;
+  }
+  options.arguments = makeArguments( options );
+
+  // In watch mode, every resident translation unit keeps a precompiled preamble of its own. A
+  // shared PCH could not be rebuilt when one of the shared includes changes.
+  RomanoViolet::SharedPreamble preamble;
+  if ( options.sharedPreamble && !options.watch
+       && preamble.Build( options.headers, commandLineOf( options ) ) ) {
+    options.preamble = &preamble;
+  }
+
+  // Cached results are only valid for the same parse arguments and extraction mode.
+  std::unique_ptr< RomanoViolet::ResultCache > cache;
+  if ( !options.cacheDirectory.empty( ) ) {
+    // the output format is not part of the configuration: entries hold the classes, not the output.
+    std::string configuration
+        = options.allClasses ? "all-classes" : ( options.singlePass ? "single-pass" : "two-pass" );
+    if ( options.fullTraversal ) {
+      configuration.append( " full-traversal" );
+    }
+    // entries of the fast path depend on the header alone, and do not record its inclusions.
+    if ( options.fast ) {
+      configuration.append( " fast" );
+    }
+    // the arguments cover the stub headers; the profile changes the flags as well.
+    if ( options.leanProfile ) {
+      configuration.append( " lean" );
+    }
+    for ( const std::string &argument : options.arguments ) {
+      configuration.append( " " + argument );
+    }
+    cache.reset( new RomanoViolet::ResultCache( options.cacheDirectory, configuration ) );
+    if ( options.preamble != nullptr ) {
+      cache->AddSharedInclusions( preamble.GetInclusions( ) );
+    }
+    options.cache = cache.get( );
+  }
+
+  RomanoViolet::Instrumentation instrumentation;
+  if ( !options.profile.empty( ) ) {
+    options.instrumentation = &instrumentation;
+  }
+
+  std::unique_ptr< RomanoViolet::CursorLogWriter > cursorLog;
+  if ( !options.cursorLogFile.empty( ) ) {
+    cursorLog.reset( new RomanoViolet::CursorLogWriter( options.cursorLogFile ) );
+    if ( !cursorLog->IsOpen( ) ) {
+      std::cerr << "Unable to open cursor log: " << options.cursorLogFile << "\n";
+      return EXIT_FAILURE;
+    }
+    options.cursorLog = cursorLog.get( );
+  }
+
+  using Phase = RomanoViolet::Instrumentation::Phase;
+  if ( options.watch ) {
+    // The class is always discovered by the state machine: a separate first parse would not
+    // benefit from the resident translation unit. Watch mode is single threaded, so everything is
+    // recorded into options.instrumentation directly. Reparses are not timed.
+    std::unique_ptr< RomanoViolet::WatchMode > watchMode;
+    {
+      // the index is created along with the watch mode.
+      RomanoViolet::Instrumentation::Timer timer( options.instrumentation, Phase::INDEX_CREATION );
+      watchMode.reset( new RomanoViolet::WatchMode(
+          options.headers,
+          [&options]( CXIndex index, const std::string &header ) {
+            RomanoViolet::Instrumentation::Timer timer( options.instrumentation, Phase::PARSE );
+            return parseForExtraction(
+                index,
+                header.c_str( ),
+                options,
+                CXTranslationUnit_Flags::CXTranslationUnit_PrecompiledPreamble
+                    | CXTranslationUnit_Flags::CXTranslationUnit_CreatePreambleOnFirstParse );
+          },
+          [&options]( CXTranslationUnit tu, const std::string &header, std::ostream &out ) {
+            extractFromTranslationUnit(
+                tu, header.c_str( ), "", "", options, options.instrumentation, out );
+          } ) );
+    }
+    if ( !watchMode->Run( std::cout ) ) {
+      return EXIT_FAILURE;
+    }
+  } else if ( options.headers.size( ) == 1 ) {
+    CXIndex index;
+    {
+      RomanoViolet::Instrumentation::Timer timer( options.instrumentation, Phase::INDEX_CREATION );
+      index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                 /*displayDiagnostics=*/true );
+    }
+    extractHeader( index, options.headers.front( ).c_str( ), options, std::cout );
+    clang_disposeIndex( index );
   } else {
-    data.p = &p;
-    traverse( tu, data );
-    data.p->print( );
-    clang_disposeTranslationUnit( tu );
+    // Batch mode: headers are spread over a pool of workers, each with its own index.
+    RomanoViolet::RunBatch(
+        options.headers,
+        options.jobs,
+        [&options]( CXIndex index, const std::string &header, std::ostream &out ) {
+          extractHeader( index, header.c_str( ), options, out );
+        },
+        std::cout,
+        options.instrumentation );
+  }
+
+  if ( options.instrumentation != nullptr ) {
+    // the results have been written completely, so the report never interleaves with them.
+    std::cout.flush( );
+    if ( options.profile.compare( "json" ) == 0 ) {
+      options.instrumentation->WriteJson( std::cerr );
+    } else {
+      options.instrumentation->WriteSummary( std::cerr );
+    }
   }
-  clang_disposeIndex( index );
 }
@@ -0,0 +1,157 @@
+/**
+ * @file QueryAstSnapshot.cpp
+ * @brief Structural queries over a snapshot written by AstDump --snapshot, without libclang
+ * parsing anything.
+ * @details Lists the nodes matching all of the given conditions, one per line:
+ *   index kind spelling type file:line:column, and the spellings of the enclosing nodes.
+ * Without conditions, the number of nodes per kind is listed instead.
+ *
+ * Usage: QueryAstSnapshot [--kind <kind>] [--spelling <spelling>] [--under <spelling>] <snapshot>
+ *
+ * --kind takes the spelling of a cursor kind, e.g., FieldDecl. --under matches nodes with an
+ * ancestor spelled so, e.g., the fields of the class Component.
+ */
+
+#include "AstSnapshot.hpp"
+#include "BufferedWriter.hpp"
+#include <clang-c/Index.h>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+  using RomanoViolet::AstSnapshot;
+  using RomanoViolet::AstSnapshotNode;
+  using RomanoViolet::StringRef;
+
+  struct Query {
+    std::string kind;
+    std::string spelling;
+    std::string under;
+    std::string snapshot;
+
+    bool IsEmpty( ) const
+    {
+      return this->kind.empty( ) && this->spelling.empty( ) && this->under.empty( );
+    }
+  };
+
+  // Kind spellings are asked of libclang once per kind, not once per node.
+  const std::string &kindSpelling( std::uint32_t kind )
+  {
+    static std::unordered_map< std::uint32_t, std::string > spellings;
+    auto found = spellings.find( kind );
+    if ( found == spellings.end( ) ) {
+      const CXString spelling = clang_getCursorKindSpelling( static_cast< CXCursorKind >( kind ) );
+      found = spellings.emplace( kind, clang_getCString( spelling ) ).first;
+      clang_disposeString( spelling );
+    }
+    return found->second;
+  }
+
+  bool isUnder( const AstSnapshot &snapshot, const AstSnapshotNode &node, StringRef ancestor )
+  {
+    for ( std::uint32_t parent = node._parent; parent != AstSnapshotNode::none;
+          parent = snapshot.GetNode( parent )._parent ) {
+      if ( snapshot.GetString( snapshot.GetNode( parent )._spelling ) == ancestor ) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void writeMatch( RomanoViolet::BufferedWriter &out,
+                   const AstSnapshot &snapshot,
+                   std::uint32_t index )
+  {
+    const AstSnapshotNode &node = snapshot.GetNode( index );
+    out.WriteInteger( index );
+    out.Put( ' ' );
+    out.Write( StringRef( kindSpelling( node._kind ) ) );
+    out.Put( ' ' );
+    out.Write( snapshot.GetString( node._spelling ) );
+    out.Put( ' ' );
+    out.Write( snapshot.GetString( node._typeSpelling ) );
+    out.Put( ' ' );
+    out.Write( snapshot.GetString( node._file ) );
+    out.Put( ':' );
+    out.WriteInteger( node._startLine );
+    out.Put( ':' );
+    out.WriteInteger( node._startColumn );
+
+    // the enclosing nodes, innermost first; the root, the translation unit, is left out.
+    out.Write( " in" );
+    for ( std::uint32_t parent = node._parent;
+          ( parent != AstSnapshotNode::none )
+          && ( snapshot.GetNode( parent )._parent != AstSnapshotNode::none );
+          parent = snapshot.GetNode( parent )._parent ) {
+      out.Put( ' ' );
+      out.Write( snapshot.GetString( snapshot.GetNode( parent )._spelling ) );
+    }
+    out.Put( '\n' );
+  }  // writeMatch
+}  // namespace
+
+auto main( int argc, const char *argv[] ) -> int
+{
+  Query query;
+  for ( int i = 1; i < argc; ++i ) {
+    const std::string argument = argv[i];
+    if ( ( argument.compare( "--kind" ) == 0 ) && ( i + 1 < argc ) ) {
+      query.kind = argv[++i];
+    } else if ( ( argument.compare( "--spelling" ) == 0 ) && ( i + 1 < argc ) ) {
+      query.spelling = argv[++i];
+    } else if ( ( argument.compare( "--under" ) == 0 ) && ( i + 1 < argc ) ) {
+      query.under = argv[++i];
+    } else if ( ( argument.compare( 0, 2, "--" ) != 0 ) && query.snapshot.empty( ) ) {
+      query.snapshot = argument;
+    } else {
+      query.snapshot.clear( );
+      break;
+    }
+  }
+  if ( query.snapshot.empty( ) ) {
+    std::cerr << "Usage: " << argv[0]
+              << " [--kind <kind>] [--spelling <spelling>] [--under <spelling>] <snapshot>\n";
+    return EXIT_FAILURE;
+  }
+
+  AstSnapshot snapshot;
+  if ( !snapshot.Open( query.snapshot ) ) {
+    std::cerr << "Not a readable AST snapshot: " << query.snapshot << "\n";
+    return EXIT_FAILURE;
+  }
+
+  RomanoViolet::BufferedWriter out( std::cout );
+  if ( query.IsEmpty( ) ) {
+    std::map< std::string, std::size_t > counts;
+    for ( std::uint32_t index = 0; index < snapshot.GetNumberOfNodes( ); ++index ) {
+      ++counts[kindSpelling( snapshot.GetNode( index )._kind )];
+    }
+    for ( const auto &count : counts ) {
+      out.WriteInteger( static_cast< long long >( count.second ) );
+      out.Put( ' ' );
+      out.Write( StringRef( count.first ) );
+      out.Put( '\n' );
+    }
+    return EXIT_SUCCESS;
+  }
+
+  const StringRef spelling( query.spelling );
+  const StringRef under( query.under );
+  for ( std::uint32_t index = 0; index < snapshot.GetNumberOfNodes( ); ++index ) {
+    const AstSnapshotNode &node = snapshot.GetNode( index );
+    if ( ( !query.kind.empty( ) && ( kindSpelling( node._kind ) != query.kind ) )
+         || ( !query.spelling.empty( ) && ( snapshot.GetString( node._spelling ) != spelling ) )
+         || ( !query.under.empty( ) && !isUnder( snapshot, node, under ) ) ) {
+      continue;
+    }
+    writeMatch( out, snapshot, index );
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,257 @@
+#include "ResultCache.hpp"
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+namespace RomanoViolet
+{
+  namespace
+  {
+    // Bump whenever the layout of an entry changes.
+    constexpr const char *entryHeader = "CPPProject-cache 1";
+
+    // 64-bit FNV-1a
+    std::uint64_t hashBytes( const char *bytes,
+                             std::size_t size,
+                             std::uint64_t hash = 14695981039346656037ULL )
+    {
+      for ( std::size_t i = 0; i < size; ++i ) {
+        hash ^= static_cast< unsigned char >( bytes[i] );
+        hash *= 1099511628211ULL;
+      }
+      return hash;
+    }
+
+    std::uint64_t hashString( const std::string &string, std::uint64_t hash )
+    {
+      // the terminating null keeps ("ab", "c") apart from ("a", "bc")
+      return hashBytes( string.c_str( ), string.size( ) + 1, hash );
+    }
+
+    bool readFile( const std::string &path, std::string &contents )
+    {
+      std::ifstream file( path, std::ios::in | std::ios::binary );
+      if ( !file ) {
+        return false;
+      }
+      contents.assign( std::istreambuf_iterator< char >( file ), std::istreambuf_iterator< char >( ) );
+      return true;
+    }
+
+    void makeDirectories( const std::string &directory )
+    {
+      for ( std::size_t slash = directory.find( '/', 1 ); slash != std::string::npos;
+            slash = directory.find( '/', slash + 1 ) ) {
+        mkdir( directory.substr( 0, slash ).c_str( ), 0755 );
+      }
+      mkdir( directory.c_str( ), 0755 );
+    }
+
+    std::vector< std::string > split( const std::string &line )
+    {
+      std::vector< std::string > fields;
+      std::size_t begin = 0;
+      for ( std::size_t tab = line.find( '\t' ); tab != std::string::npos;
+            tab = line.find( '\t', begin ) ) {
+        fields.emplace_back( line.substr( begin, tab - begin ) );
+        begin = tab + 1;
+      }
+      fields.emplace_back( line.substr( begin ) );
+      return fields;
+    }
+
+    void collectInclusion( CXFile includedFile,
+                           CXSourceLocation *inclusionStack,
+                           unsigned includeLength,
+                           CXClientData clientData )
+    {
+      ( void )inclusionStack;
+      ( void )includeLength;
+      auto *inclusions = static_cast< std::vector< std::string > * >( clientData );
+      CXString fileName = clang_getFileName( includedFile );
+      inclusions->emplace_back( clang_getCString( fileName ) );
+      clang_disposeString( fileName );
+    }
+  }  // namespace
+
+  ResultCache::ResultCache( const std::string &directory, const std::string &configuration )
+      : _directory( directory )
+      , _configuration( configuration )
+      , _sharedInclusions( )
+      , _fileHashes( )
+      , _fileHashesMutex( )
+  {
+    makeDirectories( this->_directory );
+  }
+
+  void ResultCache::AddSharedInclusions( const std::vector< std::string > &inclusions )
+  {
+    this->_sharedInclusions.insert(
+        this->_sharedInclusions.end( ), inclusions.begin( ), inclusions.end( ) );
+  }  // ResultCache::AddSharedInclusions
+
+  bool ResultCache::HashFile( const std::string &path, std::uint64_t &hash )
+  {
+    // stat before reading: a change while reading leaves a newer modification time, which the next
+    // call does not find in the memo.
+    struct stat status;
+    if ( stat( path.c_str( ), &status ) != 0 ) {
+      return false;
+    }
+    FileHash fileHash;
+    fileHash.size = static_cast< long long >( status.st_size );
+    fileHash.modificationSeconds = static_cast< long long >( status.st_mtim.tv_sec );
+    fileHash.modificationNanoseconds = static_cast< long long >( status.st_mtim.tv_nsec );
+
+    {
+      std::lock_guard< std::mutex > lock( this->_fileHashesMutex );
+      const auto known = this->_fileHashes.find( path );
+      if ( ( known != this->_fileHashes.end( ) ) && ( known->second.size == fileHash.size )
+           && ( known->second.modificationSeconds == fileHash.modificationSeconds )
+           && ( known->second.modificationNanoseconds == fileHash.modificationNanoseconds ) ) {
+        hash = known->second.hash;
+        return true;
+      }
+    }
+
+    std::string contents;
+    if ( !readFile( path, contents ) ) {
+      return false;
+    }
+    hash = hashBytes( contents.data( ), contents.size( ) );
+    fileHash.hash = hash;
+
+    std::lock_guard< std::mutex > lock( this->_fileHashesMutex );
+    this->_fileHashes[path] = fileHash;
+    return true;
+  }  // ResultCache::HashFile
+
+  bool ResultCache::EntryPath( const std::string &header, std::string &entryPath )
+  {
+    std::uint64_t contentHash;
+    if ( !this->HashFile( header, contentHash ) ) {
+      return false;
+    }
+
+    // quoted includes are resolved relative to the header, therefore its path is part of the key.
+    std::uint64_t key = hashString( this->_configuration, contentHash );
+    key = hashString( header, key );
+
+    char name[17];
+    std::snprintf( name, sizeof( name ), "%016llx", static_cast< unsigned long long >( key ) );
+    entryPath = this->_directory + "/" + name + ".entry";
+    return true;
+  }  // ResultCache::EntryPath
+
+  bool ResultCache::Lookup( const std::string &header,
+                            StringPool &strings,
+                            std::vector< StateMachine::ClassDetails > &inspectedClasses )
+  {
+    std::string entryPath;
+    std::string entry;
+    if ( !this->EntryPath( header, entryPath ) || !readFile( entryPath, entry ) ) {
+      return false;
+    }
+
+    std::istringstream lines( entry );
+    std::string line;
+    if ( !std::getline( lines, line ) || ( line.compare( entryHeader ) != 0 ) ) {
+      return false;
+    }
+
+    std::vector< StateMachine::ClassDetails > restored;
+    while ( std::getline( lines, line ) ) {
+      const std::vector< std::string > fields = split( line );
+      if ( ( fields[0].compare( "I" ) == 0 ) && ( fields.size( ) == 3 ) ) {
+        // I <hash> <included file>: stale if the included file changed or vanished.
+        // a corrupt or truncated hash is a miss, as is any other malformed line.
+        char *end = nullptr;
+        errno = 0;
+        const unsigned long long storedHash = std::strtoull( fields[1].c_str( ), &end, 16 );
+        if ( fields[1].empty( ) || ( *end != '\0' ) || ( errno != 0 ) ) {
+          return false;
+        }
+        std::uint64_t hash;
+        if ( !this->HashFile( fields[2], hash ) || ( hash != storedHash ) ) {
+          return false;
+        }
+      } else if ( ( fields[0].compare( "C" ) == 0 ) && ( fields.size( ) == 4 ) ) {
+        // C <name> <namespace> <base class>
+        StateMachine::ClassDetails classDetails;
+        classDetails._name = strings.Intern( StringRef( fields[1] ) );
+        classDetails._namespace = strings.Intern( StringRef( fields[2] ) );
+        classDetails._baseclass = strings.Intern( StringRef( fields[3] ) );
+        restored.emplace_back( classDetails );
+      } else if ( ( fields[0].compare( "O" ) == 0 ) && ( fields.size( ) == 5 )
+                  && !restored.empty( ) ) {
+        // O <io name> <type> <direction> <namespace>, belonging to the preceding class
+        StateMachine::IODetails io;
+        io._ioName = strings.Intern( StringRef( fields[1] ) );
+        io._type = strings.Intern( StringRef( fields[2] ) );
+        io._direction = strings.Intern( StringRef( fields[3] ) );
+        io._namespace = strings.Intern( StringRef( fields[4] ) );
+        restored.back( )._io.emplace_back( io );
+      } else {
+        return false;
+      }
+    }
+
+    inspectedClasses = restored;
+    return true;
+  }  // ResultCache::Lookup
+
+  void ResultCache::Store( const std::string &header,
+                           CXTranslationUnit tu,
+                           const std::vector< StateMachine::ClassDetails > &inspectedClasses )
+  {
+    std::string entryPath;
+    if ( !this->EntryPath( header, entryPath ) ) {
+      return;
+    }
+
+    // the main file is reported as well, at the bottom of the inclusion stack.
+    std::vector< std::string > inclusions( this->_sharedInclusions );
+    clang_getInclusions( tu, collectInclusion, &inclusions );
+
+    std::ostringstream entry;
+    entry << entryHeader << "\n";
+    for ( const std::string &inclusion : inclusions ) {
+      std::uint64_t hash;
+      if ( !this->HashFile( inclusion, hash ) ) {
+        // an entry which cannot be validated later on must not be written.
+        return;
+      }
+      entry << "I\t" << std::hex << hash << std::dec << "\t" << inclusion << "\n";
+    }
+    for ( const StateMachine::ClassDetails &classDetails : inspectedClasses ) {
+      entry << "C\t" << classDetails._name << "\t" << classDetails._namespace << "\t"
+            << classDetails._baseclass << "\n";
+      for ( const StateMachine::IODetails &io : classDetails._io ) {
+        entry << "O\t" << io._ioName << "\t" << io._type << "\t" << io._direction << "\t"
+              << io._namespace << "\n";
+      }
+    }
+
+    // write-then-rename, so that concurrent workers and processes never see a partial entry.
+    const std::string temporaryPath
+        = entryPath + "." + std::to_string( getpid( ) ) + "."
+          + std::to_string( std::hash< std::thread::id >( )( std::this_thread::get_id( ) ) );
+    {
+      std::ofstream file( temporaryPath, std::ios::out | std::ios::binary | std::ios::trunc );
+      file << entry.str( );
+      if ( !file ) {
+        std::remove( temporaryPath.c_str( ) );
+        return;
+      }
+    }
+    if ( std::rename( temporaryPath.c_str( ), entryPath.c_str( ) ) != 0 ) {
+      std::remove( temporaryPath.c_str( ) );
+    }
+  }  // ResultCache::Store
+}  // namespace RomanoViolet
@@ -0,0 +1,74 @@
+#ifndef _RESULTCACHE_HPP_
+#define _RESULTCACHE_HPP_
+
+#include "StateMachine.hpp"
+#include <clang-c/Index.h>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Persistent, content-addressed store of the class details extracted from headers.
+   * @details An entry is addressed by the hash of the header's content and of the parse
+   * configuration. It records the content hash of every file the header included when it was
+   * parsed (see clang_getInclusions), and is only returned if none of them has changed since.
+   * A hit therefore skips libclang entirely. Safe to share between batch workers.
+   */
+  class ResultCache
+  {
+  public:
+    /**
+     * @param directory: Where entries are stored. Created if it does not exist.
+     * @param configuration: Everything besides file contents which influences the result, e.g.,
+     * the parse arguments. Entries made under a different configuration are never returned.
+     */
+    ResultCache( const std::string &directory, const std::string &configuration );
+
+    /**
+     * @brief Files every stored entry depends on in addition to the ones reported by
+     * clang_getInclusions, e.g., the files compiled into a PCH used for parsing.
+     */
+    void AddSharedInclusions( const std::vector< std::string > &inclusions );
+
+    /**
+     * @brief Looks up the details for header.
+     * @return true on a hit, in which case inspectedClasses holds the stored details. Their strings
+     * are interned in strings.
+     */
+    bool Lookup( const std::string &header,
+                 StringPool &strings,
+                 std::vector< StateMachine::ClassDetails > &inspectedClasses );
+
+    /**
+     * @brief Stores the details extracted from tu, which is the parse of header.
+     */
+    void Store( const std::string &header,
+                CXTranslationUnit tu,
+                const std::vector< StateMachine::ClassDetails > &inspectedClasses );
+
+  private:
+    const std::string _directory;
+    const std::string _configuration;
+    std::vector< std::string > _sharedInclusions;
+
+    // content hash of a file, valid as long as its size and modification time stay the same.
+    struct FileHash {
+      long long size;
+      long long modificationSeconds;
+      long long modificationNanoseconds;
+      std::uint64_t hash;
+    };
+
+    // content hashes of files seen during this run. System headers are shared by all headers,
+    // and are only read once, unless they change, e.g., between the reparses of --watch.
+    std::map< std::string, FileHash > _fileHashes;
+    std::mutex _fileHashesMutex;
+
+    bool HashFile( const std::string &path, std::uint64_t &hash );
+    bool EntryPath( const std::string &header, std::string &entryPath );
+  };  // class ResultCache
+}  // namespace RomanoViolet
+#endif  // !_RESULTCACHE_HPP_
@@ -0,0 +1,234 @@
+#include "ResultSink.hpp"
+#include <cstdint>
+#include <cstdio>
+namespace RomanoViolet
+{
+  bool ParseOutputFormat( const std::string &format, OutputFormat &outputFormat )
+  {
+    if ( format.compare( "text" ) == 0 ) {
+      outputFormat = OutputFormat::TEXT;
+    } else if ( format.compare( "jsonl" ) == 0 ) {
+      outputFormat = OutputFormat::JSON_LINES;
+    } else if ( format.compare( "binary" ) == 0 ) {
+      outputFormat = OutputFormat::BINARY;
+    } else {
+      return false;
+    }
+    return true;
+  }  // ParseOutputFormat
+
+  namespace
+  {
+    // Same layout as StateMachine::print has always used.
+    class TextSink : public ResultSink
+    {
+    public:
+      TextSink( BufferedWriter &writer, bool labelHeaders )
+          : _writer( writer ), _labelHeaders( labelHeaders )
+      {
+      }
+
+      void BeginHeader( const std::string &header ) override
+      {
+        if ( this->_labelHeaders ) {
+          this->_writer.Write( "Header: " );
+          this->_writer.Write( StringRef( header ) );
+          this->_writer.Put( '\n' );
+        }
+      }
+
+      void WriteClass( const std::string &header,
+                       const StateMachine::ClassDetails &classDetails ) override
+      {
+        ( void )header;
+        this->_writer.WriteLeft( "Class Name: ", 20 );
+        this->_writer.Write( classDetails._namespace );
+        this->_writer.Write( "::" );
+        this->_writer.Write( classDetails._name );
+        this->_writer.Put( '\n' );
+
+        this->_writer.WriteLeft( "Base Class: ", 25 );
+        this->_writer.Write( classDetails._baseclass );
+        this->_writer.Put( '\n' );
+
+        // inputs first, then outputs, then everything else.
+        this->WriteIO( classDetails, "In", "Input: " );
+        this->WriteIO( classDetails, "Out", "Output: " );
+        this->WriteIO( classDetails, "", "Ambiguous: " );
+      }
+
+    private:
+      BufferedWriter &_writer;
+      const bool _labelHeaders;
+
+      void WriteIO( const StateMachine::ClassDetails &classDetails,
+                    const char *direction,
+                    const char *label )
+      {
+        for ( const StateMachine::IODetails &io : classDetails._io ) {
+          if ( io._direction == direction ) {
+            this->_writer.WriteRight( label, 25 );
+            this->_writer.WriteLeft( io._ioName, 15 );
+            this->_writer.WriteLeft( "Type: ", 7 );
+            this->_writer.Write( io._type );
+            this->_writer.Put( '\n' );
+          }
+        }
+      }
+    };  // class TextSink
+
+    // {"header":"...","namespace":"NN::RomanoViolet","class":"Component","base":"...",
+    //  "io":[{"name":"a_in","type":"...","namespace":"...","direction":"In"},...]}
+    // IO is listed in order of declaration. The direction is one of "In", "Out" or "Ambiguous".
+    class JsonLinesSink : public ResultSink
+    {
+    public:
+      explicit JsonLinesSink( BufferedWriter &writer ) : _writer( writer )
+      {
+      }
+
+      void BeginHeader( const std::string &header ) override
+      {
+        ( void )header;
+      }
+
+      void WriteClass( const std::string &header,
+                       const StateMachine::ClassDetails &classDetails ) override
+      {
+        this->_writer.Write( "{\"header\":" );
+        this->WriteString( StringRef( header ) );
+        this->_writer.Write( ",\"namespace\":" );
+        this->WriteString( classDetails._namespace );
+        this->_writer.Write( ",\"class\":" );
+        this->WriteString( classDetails._name );
+        this->_writer.Write( ",\"base\":" );
+        this->WriteString( classDetails._baseclass );
+        this->_writer.Write( ",\"io\":[" );
+        for ( std::size_t i = 0; i < classDetails._io.size( ); ++i ) {
+          const StateMachine::IODetails &io = classDetails._io[i];
+          this->_writer.Write( ( i == 0 ) ? "{\"name\":" : ",{\"name\":" );
+          this->WriteString( io._ioName );
+          this->_writer.Write( ",\"type\":" );
+          this->WriteString( io._type );
+          this->_writer.Write( ",\"namespace\":" );
+          this->WriteString( io._namespace );
+          this->_writer.Write( ",\"direction\":" );
+          this->WriteString( io._direction.empty( ) ? StringRef( "Ambiguous" ) : io._direction );
+          this->_writer.Put( '}' );
+        }
+        this->_writer.Write( "]}\n" );
+      }
+
+    private:
+      BufferedWriter &_writer;
+
+      void WriteString( StringRef string )
+      {
+        this->_writer.Put( '"' );
+        for ( const char character : string ) {
+          if ( ( character == '"' ) || ( character == '\\' ) ) {
+            this->_writer.Put( '\\' );
+            this->_writer.Put( character );
+          } else if ( static_cast< unsigned char >( character ) < 0x20 ) {
+            char escaped[7];
+            std::snprintf(
+                escaped, sizeof( escaped ), "\\u%04x", static_cast< unsigned >( character ) );
+            this->_writer.Write( escaped, 6 );
+          } else {
+            this->_writer.Put( character );
+          }
+        }
+        this->_writer.Put( '"' );
+      }
+    };  // class JsonLinesSink
+
+    // One record per class. All integers are little endian, strings are a u32 length followed by
+    // the bytes of the string.
+    //   u32 length of the remainder of the record
+    //   u8  record kind, 'C' for a class
+    //   str header, str namespace, str class, str base class
+    //   u32 number of IO, each of which is
+    //     u8 direction (0: ambiguous, 1: input, 2: output), str name, str type, str namespace
+    class BinarySink : public ResultSink
+    {
+    public:
+      explicit BinarySink( BufferedWriter &writer ) : _writer( writer ), _record( )
+      {
+      }
+
+      void BeginHeader( const std::string &header ) override
+      {
+        ( void )header;
+      }
+
+      void WriteClass( const std::string &header,
+                       const StateMachine::ClassDetails &classDetails ) override
+      {
+        this->_record.clear( );
+        this->_record.push_back( 'C' );
+        this->AppendString( StringRef( header ) );
+        this->AppendString( classDetails._namespace );
+        this->AppendString( classDetails._name );
+        this->AppendString( classDetails._baseclass );
+        this->AppendNumber( classDetails._io.size( ) );
+        for ( const StateMachine::IODetails &io : classDetails._io ) {
+          char direction = 0;
+          if ( io._direction == "In" ) {
+            direction = 1;
+          } else if ( io._direction == "Out" ) {
+            direction = 2;
+          }
+          this->_record.push_back( direction );
+          this->AppendString( io._ioName );
+          this->AppendString( io._type );
+          this->AppendString( io._namespace );
+        }
+
+        char length[4];
+        encode( this->_record.size( ), length );
+        this->_writer.Write( length, sizeof( length ) );
+        this->_writer.Write( StringRef( this->_record ) );
+      }
+
+    private:
+      BufferedWriter &_writer;
+      // the record is assembled first, since it is prefixed by its length.
+      std::string _record;
+
+      static void encode( std::size_t number, char bytes[4] )
+      {
+        const std::uint32_t value = static_cast< std::uint32_t >( number );
+        for ( int i = 0; i < 4; ++i ) {
+          bytes[i] = static_cast< char >( ( value >> ( 8 * i ) ) & 0xFFU );
+        }
+      }
+
+      void AppendNumber( std::size_t number )
+      {
+        char bytes[4];
+        encode( number, bytes );
+        this->_record.append( bytes, sizeof( bytes ) );
+      }
+
+      void AppendString( StringRef string )
+      {
+        this->AppendNumber( string.size( ) );
+        this->_record.append( string.data( ), string.size( ) );
+      }
+    };  // class BinarySink
+  }  // namespace
+
+  std::unique_ptr< ResultSink >
+  MakeResultSink( OutputFormat format, BufferedWriter &writer, bool labelHeaders )
+  {
+    switch ( format ) {
+      case OutputFormat::JSON_LINES:
+        return std::unique_ptr< ResultSink >( new JsonLinesSink( writer ) );
+      case OutputFormat::BINARY:
+        return std::unique_ptr< ResultSink >( new BinarySink( writer ) );
+      case OutputFormat::TEXT:
+      default:
+        return std::unique_ptr< ResultSink >( new TextSink( writer, labelHeaders ) );
+    }
+  }  // MakeResultSink
+}  // namespace RomanoViolet
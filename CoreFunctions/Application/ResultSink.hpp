@@ -0,0 +1,46 @@
+#ifndef _RESULTSINK_HPP_
+#define _RESULTSINK_HPP_
+
+#include "BufferedWriter.hpp"
+#include "StateMachine.hpp"
+#include <memory>
+#include <ostream>
+#include <string>
+namespace RomanoViolet
+{
+  enum class OutputFormat : short {
+    TEXT,        ///< The human readable table, see README.md.
+    JSON_LINES,  ///< One JSON object per class and line.
+    BINARY       ///< One length-prefixed record per class, see ResultSink.cpp.
+  };
+
+  /**
+   * @brief Parses "text", "jsonl" or "binary".
+   * @return false if format names none of them.
+   */
+  bool ParseOutputFormat( const std::string &format, OutputFormat &outputFormat );
+
+  /**
+   * @brief Receives the classes extracted from headers, and writes them in one of the formats.
+   */
+  class ResultSink
+  {
+  public:
+    virtual ~ResultSink( ) = default;
+
+    // Called once per header, before any of its classes.
+    virtual void BeginHeader( const std::string &header ) = 0;
+
+    virtual void WriteClass( const std::string &header,
+                             const StateMachine::ClassDetails &classDetails )
+        = 0;
+  };  // class ResultSink
+
+  /**
+   * @param labelHeaders: Whether the text format starts every header with a "Header: <path>" line.
+   * The other formats name the header in every record.
+   */
+  std::unique_ptr< ResultSink >
+  MakeResultSink( OutputFormat format, BufferedWriter &writer, bool labelHeaders );
+}  // namespace RomanoViolet
+#endif  // !_RESULTSINK_HPP_
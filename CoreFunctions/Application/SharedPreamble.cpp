@@ -0,0 +1,285 @@
+#include "SharedPreamble.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <clang-c/Index.h>
+#include <climits>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <dirent.h>
+#include <fstream>
+#include <iostream>
+#include <sys/stat.h>
+#include <unistd.h>
+namespace RomanoViolet
+{
+  namespace
+  {
+    // Include roots shared by all components.
+    constexpr const char *sharedIncludeRoots[] = { "Library/", "BoundedTypes/" };
+
+    bool isSharedInclude( const std::string &include )
+    {
+      for ( const char *root : sharedIncludeRoots ) {
+        if ( include.compare( 0, std::char_traits< char >::length( root ), root ) == 0 ) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void collectInclusion( CXFile includedFile,
+                           CXSourceLocation *inclusionStack,
+                           unsigned includeLength,
+                           CXClientData clientData )
+    {
+      ( void )inclusionStack;
+      // the umbrella header itself only exists in memory.
+      if ( includeLength == 0 ) {
+        return;
+      }
+      auto *inclusions = static_cast< std::vector< std::string > * >( clientData );
+      CXString fileName = clang_getFileName( includedFile );
+      inclusions->emplace_back( clang_getCString( fileName ) );
+      clang_disposeString( fileName );
+    }
+
+    std::string temporaryDirectory( )
+    {
+      const char *directory = std::getenv( "TMPDIR" );
+      return ( directory == nullptr ) ? std::string( "/tmp" ) : std::string( directory );
+    }
+
+    // Name of the files of the process pid, e.g., CPPProject-1234-shared.pch.
+    constexpr const char *pchPrefix = "CPPProject-";
+    constexpr const char *pchSuffix = "-shared.pch";
+    // Age after which a PCH file of a process which does not exist here is taken as left behind.
+    // In a temporary directory shared with other PID namespaces, e.g., containers, the process may
+    // well exist there. A PCH is written once, when a run starts.
+    constexpr std::time_t stalePchAge = 24 * 60 * 60;
+
+    // The PCH file being built or used, for removeOnSignal( ), which cannot touch a std::string.
+    // Empty if there is none.
+    char pchPathOnSignal[PATH_MAX] = "";
+    using SignalHandler = void ( * )( int );
+    SignalHandler previousInterruptHandler = SIG_DFL;
+    SignalHandler previousTerminateHandler = SIG_DFL;
+
+    // Removes the PCH file, which the destructor will not get to, then ends the process as the
+    // signal would have.
+    void removeOnSignal( int signal )
+    {
+      if ( pchPathOnSignal[0] != '\0' ) {
+        unlink( pchPathOnSignal );
+      }
+      std::signal( signal, SIG_DFL );
+      std::raise( signal );
+    }
+
+    // Signals which were ignored, e.g., SIGINT of a background job, stay ignored.
+    SignalHandler installRemoveOnSignal( int signal )
+    {
+      const SignalHandler previous = std::signal( signal, removeOnSignal );
+      if ( previous == SIG_IGN ) {
+        std::signal( signal, SIG_IGN );
+      }
+      return previous;
+    }
+
+    // Has removeOnSignal( ) remove pchPath on SIGINT and SIGTERM.
+    void removePchOnSignal( const std::string &pchPath )
+    {
+      std::strcpy( pchPathOnSignal, pchPath.c_str( ) );
+      previousInterruptHandler = installRemoveOnSignal( SIGINT );
+      previousTerminateHandler = installRemoveOnSignal( SIGTERM );
+    }
+
+    // Restores the handlers removePchOnSignal( pchPath ) replaced, and removes the PCH file.
+    void removePch( const std::string &pchPath )
+    {
+      std::signal( SIGINT, previousInterruptHandler );
+      std::signal( SIGTERM, previousTerminateHandler );
+      pchPathOnSignal[0] = '\0';
+      std::remove( pchPath.c_str( ) );
+    }
+
+    // Removes the PCH files of earlier runs in directory whose process no longer exists, i.e.,
+    // which were ended before they could remove their own. Only files of the current user older
+    // than stalePchAge are removed.
+    void removeStalePchFiles( const std::string &directory )
+    {
+      DIR *entries = opendir( directory.c_str( ) );
+      if ( entries == nullptr ) {
+        return;
+      }
+      const std::size_t prefixLength = std::strlen( pchPrefix );
+      const std::size_t suffixLength = std::strlen( pchSuffix );
+      const std::time_t now = std::time( nullptr );
+      for ( dirent *entry = readdir( entries ); entry != nullptr; entry = readdir( entries ) ) {
+        const std::string name = entry->d_name;
+        if ( ( name.size( ) <= prefixLength + suffixLength )
+             || ( name.compare( 0, prefixLength, pchPrefix ) != 0 )
+             || ( name.compare( name.size( ) - suffixLength, suffixLength, pchSuffix ) != 0 ) ) {
+          continue;
+        }
+        char *end = nullptr;
+        const long pid = std::strtol( name.c_str( ) + prefixLength, &end, 10 );
+        if ( ( pid <= 0 ) || ( end != name.c_str( ) + name.size( ) - suffixLength ) ) {
+          continue;
+        }
+        const std::string path = directory + "/" + name;
+        struct stat status;
+        if ( ( lstat( path.c_str( ), &status ) != 0 ) || !S_ISREG( status.st_mode )
+             || ( status.st_uid != getuid( ) ) || ( now - status.st_mtime < stalePchAge ) ) {
+          continue;
+        }
+        if ( ( kill( static_cast< pid_t >( pid ), 0 ) != 0 ) && ( errno == ESRCH ) ) {
+          std::remove( path.c_str( ) );
+        }
+      }
+      closedir( entries );
+    }
+  }  // namespace
+
+  SharedPreamble::~SharedPreamble( )
+  {
+    if ( !this->_pchPath.empty( ) ) {
+      removePch( this->_pchPath );
+    }
+  }
+
+  void SharedPreamble::CollectSharedIncludes( const std::string &header,
+                                              std::vector< std::string > &includes )
+  {
+    std::ifstream file( header );
+    std::string line;
+    while ( std::getline( file, line ) ) {
+      // #include <Library/...> or #include "Library/..."
+      const std::size_t hash = line.find_first_not_of( " \t" );
+      if ( ( hash == std::string::npos ) || ( line[hash] != '#' ) ) {
+        continue;
+      }
+      const std::size_t directive = line.find_first_not_of( " \t", hash + 1 );
+      if ( ( directive == std::string::npos ) || ( line.compare( directive, 7, "include" ) != 0 ) ) {
+        continue;
+      }
+      const std::size_t open = line.find_first_of( "<\"", directive + 7 );
+      if ( open == std::string::npos ) {
+        continue;
+      }
+      const std::size_t close = line.find_first_of( ">\"", open + 1 );
+      if ( close == std::string::npos ) {
+        continue;
+      }
+
+      const std::string include = line.substr( open + 1, close - open - 1 );
+      // first-seen order is kept, since include order may matter to headers without guards.
+      if ( isSharedInclude( include )
+           && ( std::find( includes.begin( ), includes.end( ), include ) == includes.end( ) ) ) {
+        includes.emplace_back( include );
+      }
+    }
+  }  // SharedPreamble::CollectSharedIncludes
+
+  bool SharedPreamble::Build( const std::vector< std::string > &headers,
+                              const std::vector< const char * > &arguments )
+  {
+    std::vector< std::string > includes;
+    // per header, its own shared includes, sorted.
+    std::vector< std::vector< std::string > > includesOfHeaders( headers.size( ) );
+    for ( std::size_t i = 0; i < headers.size( ); ++i ) {
+      CollectSharedIncludes( headers[i], includesOfHeaders[i] );
+      std::sort( includesOfHeaders[i].begin( ), includesOfHeaders[i].end( ) );
+      CollectSharedIncludes( headers[i], includes );
+    }
+    if ( includes.empty( ) ) {
+      return false;
+    }
+
+    std::string umbrella;
+    for ( const std::string &include : includes ) {
+      umbrella.append( "#include <" + include + ">\n" );
+    }
+
+    const std::string directory = temporaryDirectory( );
+    removeStalePchFiles( directory );
+    const std::string base = directory + "/" + pchPrefix + std::to_string( getpid( ) ) + "-shared";
+    const std::string umbrellaPath = base + ".hpp";
+    const std::string pchPath = base + ".pch";
+    if ( pchPath.size( ) >= sizeof( pchPathOnSignal ) ) {
+      std::cerr << "Path of the PCH too long. Continuing without PCH.\n";
+      return false;
+    }
+
+    // the umbrella header only exists in memory.
+    CXUnsavedFile umbrellaFile;
+    umbrellaFile.Filename = umbrellaPath.c_str( );
+    umbrellaFile.Contents = umbrella.c_str( );
+    umbrellaFile.Length = umbrella.size( );
+
+    const unsigned flags = CXTranslationUnit_Flags::CXTranslationUnit_SkipFunctionBodies
+                           | CXTranslationUnit_Flags::CXTranslationUnit_Incomplete
+                           | CXTranslationUnit_Flags::CXTranslationUnit_ForSerialization;
+
+    CXIndex index = clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                       /*displayDiagnostics=*/true );
+    CXTranslationUnit tu = clang_parseTranslationUnit( index,
+                                                       /*source_filename=*/umbrellaPath.c_str( ),
+                                                       /*command_line_args=*/arguments.data( ),
+                                                       /*num_command_line_args=*/arguments.size( ),
+                                                       /*unsaved_files=*/&umbrellaFile,
+                                                       /*num_unsaved_files=*/1,
+                                                       /*options=*/flags );
+
+    bool isBuilt = false;
+    if ( tu == nullptr ) {
+      std::cerr << "Unable to parse the shared includes. Continuing without PCH.\n";
+    } else {
+      // from here on, the PCH file may exist, partially written or not.
+      removePchOnSignal( pchPath );
+      isBuilt = ( clang_saveTranslationUnit( tu, pchPath.c_str( ), clang_defaultSaveOptions( tu ) )
+                  == 0 );
+      if ( isBuilt ) {
+        clang_getInclusions( tu, collectInclusion, &this->_inclusions );
+      } else {
+        std::cerr << "Unable to save the shared includes as PCH. Continuing without PCH.\n";
+        removePch( pchPath );
+      }
+      clang_disposeTranslationUnit( tu );
+    }
+    clang_disposeIndex( index );
+
+    if ( isBuilt ) {
+      this->_pchPath = pchPath;
+      // a header which misses one of the includes would compile against the PCH only.
+      std::vector< std::string > sortedIncludes = includes;
+      std::sort( sortedIncludes.begin( ), sortedIncludes.end( ) );
+      for ( std::size_t i = 0; i < headers.size( ); ++i ) {
+        if ( includesOfHeaders[i] == sortedIncludes ) {
+          this->_headersUsingPch.insert( headers[i] );
+        }
+      }
+    }
+    return isBuilt;
+  }  // SharedPreamble::Build
+
+  bool SharedPreamble::IsUsableFor( const std::string &header ) const
+  {
+    return this->_headersUsingPch.count( header ) != 0;
+  }  // SharedPreamble::IsUsableFor
+
+  void SharedPreamble::AddArguments( std::vector< const char * > &arguments ) const
+  {
+    if ( !this->_pchPath.empty( ) ) {
+      arguments.emplace_back( "-include-pch" );
+      arguments.emplace_back( this->_pchPath.c_str( ) );
+    }
+  }  // SharedPreamble::AddArguments
+
+  const std::vector< std::string > &SharedPreamble::GetInclusions( ) const
+  {
+    return this->_inclusions;
+  }  // SharedPreamble::GetInclusions
+}  // namespace RomanoViolet
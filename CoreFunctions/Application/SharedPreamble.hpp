@@ -0,0 +1,68 @@
+#ifndef _SHAREDPREAMBLE_HPP_
+#define _SHAREDPREAMBLE_HPP_
+
+#include <string>
+#include <unordered_set>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Precompiles the include set shared by all component headers (Library/ and
+   * BoundedTypes/) once, so that each component parse only has to parse the component itself.
+   * @details libclang keeps a precompiled preamble per translation unit, which cannot be handed
+   * from one component to the next. The shared includes are therefore parsed once as a translation
+   * unit of their own and serialized into a PCH file, which every later component parse loads
+   * via -include-pch. The PCH holds the shared includes of all headers, so a header which misses
+   * one of them would compile against the PCH but not on its own: only headers including exactly
+   * the shared includes of the PCH load it, the others are parsed without (see IsUsableFor( )).
+   *
+   * The PCH file is removed when the instance is destroyed, or when SIGINT or SIGTERM end the
+   * process before. PCH files left behind by earlier runs of the same user which were ended
+   * otherwise, e.g., by SIGKILL, are removed by the next Build( ) once they are a day old.
+   */
+  class SharedPreamble
+  {
+  public:
+    SharedPreamble( ) = default;
+    ~SharedPreamble( );
+    SharedPreamble( const SharedPreamble & ) = delete;
+    SharedPreamble &operator=( const SharedPreamble & ) = delete;
+
+    /**
+     * @brief Builds the PCH from the shared includes found in headers.
+     *
+     * @param headers: The component headers which will be parsed against the PCH.
+     * @param arguments: The command line arguments used for parsing the component headers. The PCH
+     * is only accepted by clang if it was built with the same arguments.
+     * @return false if none of the headers uses a shared include, or if the PCH could not be built.
+     */
+    bool Build( const std::vector< std::string > &headers,
+                const std::vector< const char * > &arguments );
+
+    /**
+     * @brief Whether header, one of the headers given to Build( ), includes the same shared
+     * includes as the PCH, and is parsed against it. false if not built.
+     */
+    bool IsUsableFor( const std::string &header ) const;
+
+    /**
+     * @brief Adds the arguments required for loading the PCH to arguments. No-op if not built.
+     */
+    void AddArguments( std::vector< const char * > &arguments ) const;
+
+    /**
+     * @brief Files compiled into the PCH. These are not reported by clang_getInclusions for the
+     * translation units which load the PCH.
+     */
+    const std::vector< std::string > &GetInclusions( ) const;
+
+  private:
+    std::string _pchPath;
+    std::vector< std::string > _inclusions;
+    std::unordered_set< std::string > _headersUsingPch;
+
+    static void CollectSharedIncludes( const std::string &header,
+                                       std::vector< std::string > &includes );
+  };  // class SharedPreamble
+}  // namespace RomanoViolet
+#endif  // !_SHAREDPREAMBLE_HPP_
@@ -1,119 +1,87 @@
 #include "StateMachine.hpp"
+#include "Instrumentation.hpp"
+#include "ResultSink.hpp"
 #include <cassert>
-#include <iomanip>
 #include <iostream>
 namespace RomanoViolet
 {
-  // constructor
-  StateMachine::StateMachine( const std::string initialClass )
-      : _currentState( State::INIT ), _classToInspect( initialClass )
+  namespace
   {
-    // the rules
-    // Priority in case of conflicts: The event which comes first in the listing.
-    this->rules[State::INIT] = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-                                 { Event::CLASS_DECLARATION, State::CLASSNAME_COLLECTION } };
-
-    this->rules[State::NAMESPACE_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::CLASS_DECLARATION, State::CLASSNAME_COLLECTION } };
-
-    this->rules[State::CLASSNAME_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::BASECLASS_SPECIFIER, State::BASENAME_COLLECTION } };
-
-    this->rules[State::BASENAME_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::FIELD_DECLARATION, State::IONAME_COLLECTION },
-            { Event::TYPEREF, State::IDLE_AFTER_BASENAMECOLLECTION } };
-
-    this->rules[State::IDLE_AFTER_BASENAMECOLLECTION]
-        = { { Event::FIELD_DECLARATION, State::IONAME_COLLECTION } };
-
-    this->rules[State::IONAME_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::NAME_SPACE_REFERENCE, State::IONAMESPACE_COLLECTION },
-            { Event::TEMPLATE_REFERENCE, State::IODIRECTION_COLLECTION } };
-
-    this->rules[State::IONAMESPACE_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::NAME_SPACE_REFERENCE, State::IONAMESPACE_COLLECTION },
-            { Event::TEMPLATE_REFERENCE, State::IODIRECTION_COLLECTION },
-            { Event::TYPEREF, State::IOTYPE_COLLECTION } };
-
-    this->rules[State::IODIRECTION_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::TYPEREF, State::IOTYPE_COLLECTION },
-            { Event::FIELD_DECLARATION, State::IONAME_COLLECTION },
-            { Event::NAME_SPACE_REFERENCE, State::IDLE_AFTER_IODIRECTIONCOLLECTION } };
-
-    this->rules[State::IDLE_AFTER_IODIRECTIONCOLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::TYPEREF, State::IOTYPE_COLLECTION } };
-
-    this->rules[State::IOTYPE_COLLECTION]
-        = { { Event::NAMESPACE, State::NAMESPACE_COLLECTION },
-            { Event::FIELD_DECLARATION, State::IONAME_COLLECTION },
-            { Event::OTHERS, State::IDLE_AFTER_BASENAMECOLLECTION } };
+    // The rules as a table: transitions[_currentState][event] is the new state.
+    // Rules, in order of priority in case of conflicts:
+    //   1. the new state listed for the event,
+    //   2. otherwise, the new state listed for Event::OTHERS,
+    //   3. otherwise, the current state is kept.
+    // Special case: NAMESPACE_COLLECTION falls back to INIT on anything but a namespace or a class
+    // declaration.
+    constexpr StateMachine::State INIT = StateMachine::State::INIT;
+    constexpr StateMachine::State NAMESPACE = StateMachine::State::NAMESPACE_COLLECTION;
+    constexpr StateMachine::State CLASSNAME = StateMachine::State::CLASSNAME_COLLECTION;
+    constexpr StateMachine::State BASENAME = StateMachine::State::BASENAME_COLLECTION;
+    constexpr StateMachine::State IONAME = StateMachine::State::IONAME_COLLECTION;
+    constexpr StateMachine::State IONAMESPACE = StateMachine::State::IONAMESPACE_COLLECTION;
+    constexpr StateMachine::State IODIRECTION = StateMachine::State::IODIRECTION_COLLECTION;
+    constexpr StateMachine::State IOTYPE = StateMachine::State::IOTYPE_COLLECTION;
+    constexpr StateMachine::State IDLE_BASE = StateMachine::State::IDLE_AFTER_BASENAMECOLLECTION;
+    constexpr StateMachine::State IDLE_IODIR
+        = StateMachine::State::IDLE_AFTER_IODIRECTIONCOLLECTION;
+
+    constexpr std::size_t numberOfStates
+        = static_cast< std::size_t >( StateMachine::State::IDLE_AFTER_IODIRECTIONCOLLECTION ) + 1;
+    constexpr std::size_t numberOfEvents
+        = static_cast< std::size_t >( StateMachine::Event::OTHERS ) + 1;
+
+    // clang-format off
+    constexpr StateMachine::State transitions[numberOfStates][numberOfEvents] = {
+      //               NAMESPACE  CLASS_DECL  BASECLASS   TYPEREF     ACCESS      FIELD       NS_REF       TEMPLATE_REF OTHERS
+      /* INIT */     { NAMESPACE, CLASSNAME,  INIT,       INIT,       INIT,       INIT,       INIT,        INIT,        INIT },
+      /* NAMESPACE */{ NAMESPACE, CLASSNAME,  INIT,       INIT,       INIT,       INIT,       INIT,        INIT,        INIT },
+      /* CLASSNAME */{ NAMESPACE, CLASSNAME,  BASENAME,   CLASSNAME,  CLASSNAME,  CLASSNAME,  CLASSNAME,   CLASSNAME,   CLASSNAME },
+      /* BASENAME */ { NAMESPACE, BASENAME,   BASENAME,   IDLE_BASE,  BASENAME,   IONAME,     BASENAME,    BASENAME,    BASENAME },
+      /* IONAME */   { NAMESPACE, IONAME,     IONAME,     IONAME,     IONAME,     IONAME,     IONAMESPACE, IODIRECTION, IONAME },
+      /* IONAMESP. */{ NAMESPACE, IONAMESPACE,IONAMESPACE,IOTYPE,     IONAMESPACE,IONAMESPACE,IONAMESPACE, IODIRECTION, IONAMESPACE },
+      /* IODIR. */   { NAMESPACE, IODIRECTION,IODIRECTION,IOTYPE,     IODIRECTION,IONAME,     IDLE_IODIR,  IODIRECTION, IODIRECTION },
+      /* IOTYPE */   { NAMESPACE, IDLE_BASE,  IDLE_BASE,  IDLE_BASE,  IDLE_BASE,  IONAME,     IDLE_BASE,   IDLE_BASE,   IDLE_BASE },
+      /* IDLE_BASE */{ IDLE_BASE, IDLE_BASE,  IDLE_BASE,  IDLE_BASE,  IDLE_BASE,  IONAME,     IDLE_BASE,   IDLE_BASE,   IDLE_BASE },
+      /* IDLE_IODIR*/{ NAMESPACE, IDLE_IODIR, IDLE_IODIR, IOTYPE,     IDLE_IODIR, IDLE_IODIR, IDLE_IODIR,  IDLE_IODIR,  IDLE_IODIR } };
+    // clang-format on
+  }  // namespace
 
-    this->_currentState = State::INIT;
+  // constructor
+  StateMachine::StateMachine( const std::string initialClass, const bool inspectAllClasses )
+      : _strings( )
+      , _scratch( )
+      , _currentState( State::INIT )
+      , _classToInspect( inspectAllClasses ? StringRef( ) : _strings.Intern( StringRef( initialClass ) ) )
+      , _discoverClassToInspect( initialClass.empty( ) && !inspectAllClasses )
+      , _inspectAllClasses( inspectAllClasses )
+      , _inspectedClass( )
+      , _inspectedClasses( )
+      , _instrumentation( nullptr )
+  {
   }
 
   StateMachine::State StateMachine::GetNewState( const State currentState, const Event event )
   {
-    // get the vector containing all events, newState pairs
-    std::vector< std::pair< Event, _newState_t > > possibilities = this->rules[currentState];
-
-    // was a new target state successfully computed?
-    bool isNewTargetStateComputed = false;
-
-    // The new target state
-    StateMachine::State targetState;
-
-    // Index into the vector based on the event
-    for ( const std::pair< Event, _newState_t > &thisPossibility : possibilities ) {
-      if ( thisPossibility.first == event ) {
-        targetState = thisPossibility.second;
-        isNewTargetStateComputed = true;
-        break;
-      }
-    }
-
-    // Is OTHERS event listed?
-    if ( !isNewTargetStateComputed ) {
-      for ( const std::pair< Event, _newState_t > &thisPossibility : possibilities ) {
-        if ( thisPossibility.first == Event::OTHERS ) {
-          // In case no event matches, the OTHERS rule is taken.
-          // TODO Rename Event::OTHERS
-          targetState = thisPossibility.second;
-          isNewTargetStateComputed = true;
-          break;
-        }
-      }
-    }
-    // process events, such as (_currentState == NAMESPACE && !((event == CLASS_DECLARATION) ||
-    // (event == NAMESPACE))
-    if ( ( this->_currentState == State::NAMESPACE_COLLECTION )
-         && ( !( ( event == Event::NAMESPACE ) || ( event == Event::CLASS_DECLARATION ) ) ) ) {
-      targetState = State::INIT;
-      isNewTargetStateComputed = true;
-    }
-
-    if ( !isNewTargetStateComputed ) {
-      // if no new target state is computed, then state in the current state
-      targetState = currentState;
-    }
-    return ( targetState );
+    // a plain lookup: no allocation, no search, and the table is shared by all instances.
+    return transitions[static_cast< std::size_t >( currentState )]
+                      [static_cast< std::size_t >( event )];
   }
 
-  std::string StateMachine::toString( CXString cxString )
+  StringRef StateMachine::Join( const StringRef outer, const StringRef inner )
   {
-    std::string string = clang_getCString( cxString );
-    clang_disposeString( cxString );
-    return string;
-  }
+    if ( outer.empty( ) || inner.empty( ) ) {
+      return outer.empty( ) ? inner : outer;
+    }
+    // namespaces repeat, so the joined name is interned as well. Only the first join allocates.
+    this->_scratch.assign( outer.data( ), outer.size( ) );
+    this->_scratch.append( "::" );
+    this->_scratch.append( inner.data( ), inner.size( ) );
+    return this->_strings.Intern( StringRef( this->_scratch ) );
+  }  // StateMachine::Join
 
   void StateMachine::DoInStateAction( const StateMachine::State currentState,
-                                      const CXCursor cursor )
+                                      const Cursor &cursor )
   {
     switch ( currentState ) {
       case StateMachine::State::INIT: {
@@ -168,13 +136,47 @@ namespace RomanoViolet
     }
   }
 
-  // reads the AST line by line in order to advance the state machine
+  bool StateMachine::IsHandled( const CXCursorKind kind )
+  {
+    switch ( kind ) {
+      case CXCursorKind::CXCursor_Namespace:
+      case CXCursorKind::CXCursor_ClassDecl:
+      case CXCursorKind::CXCursor_CXXBaseSpecifier:
+      case CXCursorKind::CXCursor_TypeRef:
+      case CXCursorKind::CXCursor_FieldDecl:
+      case CXCursorKind::CXCursor_NamespaceRef:
+      case CXCursorKind::CXCursor_TemplateRef:
+        return true;
+      default:
+        return false;
+    }
+  }  // StateMachine::IsHandled
+
   void StateMachine::AdvanceStateMachine( const CXCursor cursor )
   {
+    // most cursors are of no interest, e.g., macro expansions: no need to set up a view for them.
     const CXCursorKind kind = clang_getCursorKind( cursor );
+    if ( StateMachine::IsHandled( kind ) ) {
+      this->Advance( Cursor( cursor ), kind );
+    }
+  }
+
+  void StateMachine::AdvanceStateMachine( const Cursor &cursor )
+  {
+    this->Advance( cursor, cursor.Kind( ) );
+  }
+
+  // reads the AST line by line in order to advance the state machine
+  void StateMachine::Advance( const Cursor &cursor, const CXCursorKind kind )
+  {
+    const State previousState = this->_currentState;
+    // whether the cursor did not belong to the class being sought.
+    bool isRolledBack = false;
     State newState;
     switch ( kind ) {
       case CXCursorKind ::CXCursor_Namespace: {
+        // a namespace never opens inside a class: the class being inspected is complete.
+        this->CloseInspectedClass( );
         newState = this->GetNewState( this->_currentState, Event::NAMESPACE );
         this->_currentState = newState;
         this->DoInStateAction( this->_currentState, cursor );
@@ -183,14 +185,23 @@ namespace RomanoViolet
       }
 
       case CXCursorKind::CXCursor_ClassDecl: {
+        if ( this->_inspectAllClasses ) {
+          this->InspectNextClass( cursor );
+          break;
+        }
+
         newState = this->GetNewState( this->_currentState, Event::CLASS_DECLARATION );
         this->_currentState = newState;
         this->DoInStateAction( this->_currentState, cursor );
 
+        // in discovery mode, the first class defined in the main file becomes the one we are after
+        this->DiscoverClassToInspect( cursor );
+
         // if the class name does not match the one that we are after
         if ( this->_classDetails._name.compare( this->_classToInspect ) != 0 ) {
           // roll back the state
           newState = StateMachine::State::INIT;
+          isRolledBack = true;
           this->_currentState = newState;
           this->DoInStateAction( this->_currentState, cursor );
         }
@@ -206,6 +217,7 @@ namespace RomanoViolet
         } else {
           // if it is not the class that is being sought, go back to initial state.
           newState = StateMachine::State::INIT;
+          isRolledBack = true;
           this->_currentState = newState;
         }
         this->DoInStateAction( this->_currentState, cursor );
@@ -220,6 +232,7 @@ namespace RomanoViolet
         } else {
           // if it is not the class that is being sought, go back to initial state.
           newState = StateMachine::State::INIT;
+          isRolledBack = true;
           this->_currentState = newState;
         }
 
@@ -229,6 +242,11 @@ namespace RomanoViolet
       }
 
       case CXCursorKind::CXCursor_FieldDecl: {
+        // e.g., fields of a struct declared between two classes
+        if ( !this->IsFieldOfInspectedClass( cursor ) ) {
+          break;
+        }
+
         // The new state is always IONAME_COLLECTION
         StateMachine::State _oldState = this->_currentState;
         size_t nIOPrior = this->_classDetails._io.size( );
@@ -269,8 +287,100 @@ namespace RomanoViolet
         // this->_currentState = newState;
         break;
     }
+
+    if ( this->_instrumentation != nullptr ) {
+      if ( this->_currentState != previousState ) {
+        this->_instrumentation->CountTransition( this->_currentState );
+      }
+      if ( isRolledBack ) {
+        this->_instrumentation->CountRollback( );
+      }
+    }
   }
 
+  void StateMachine::SetInstrumentation( Instrumentation *instrumentation )
+  {
+    this->_instrumentation = instrumentation;
+  }  // StateMachine::SetInstrumentation
+
+  void StateMachine::DiscoverClassToInspect( const Cursor &cursor )
+  {
+    if ( !this->_discoverClassToInspect || !this->_classToInspect.empty( ) ) {
+      return;
+    }
+
+    // Classes pulled in from included headers (e.g., TypeHighAssuranceComponent) precede the
+    // component in a full parse, and forward declarations carry no IO. Skip both.
+    if ( ( this->_currentState == State::CLASSNAME_COLLECTION ) && cursor.IsFromMainFile( )
+         && cursor.IsDefinition( ) ) {
+      this->_classToInspect = this->_classDetails._name;
+    }
+  }  // StateMachine::DiscoverClassToInspect
+
+  void StateMachine::InspectNextClass( const Cursor &cursor )
+  {
+    // Nested classes are part of the class being inspected.
+    if ( !cursor.IsAtNamespaceScope( ) ) {
+      return;
+    }
+
+    this->CloseInspectedClass( );
+
+    // As in discovery mode, classes from included headers and forward declarations are skipped.
+    if ( !cursor.IsFromMainFile( ) || !cursor.IsDefinition( ) ) {
+      this->_currentState = State::INIT;
+      this->DoInStateAction( this->_currentState, cursor );
+      return;
+    }
+
+    this->ResetAllData( );
+    this->_currentState = State::CLASSNAME_COLLECTION;
+    this->DoInStateAction( this->_currentState, cursor );
+    this->_classToInspect = this->_classDetails._name;
+    this->_inspectedClass = cursor;
+
+    // The namespaces collected on the way are only complete for the first class in a namespace.
+    // Take them from the semantic parents instead.
+    this->_classDetails._namespace = cursor.EnclosingNamespaces( this->_strings );
+  }  // StateMachine::InspectNextClass
+
+  void StateMachine::CloseInspectedClass( )
+  {
+    if ( !this->_inspectAllClasses || this->_inspectedClass.IsNull( ) ) {
+      return;
+    }
+
+    this->_inspectedClasses.emplace_back( this->_classDetails );
+    this->_inspectedClass = Cursor( );
+    this->_classToInspect = StringRef( );
+    this->_currentState = State::INIT;
+    this->DoInStateAction( this->_currentState, this->_inspectedClass );
+  }  // StateMachine::CloseInspectedClass
+
+  bool StateMachine::IsFieldOfInspectedClass( const Cursor &cursor )
+  {
+    if ( !this->_inspectAllClasses ) {
+      return true;
+    }
+    return cursor.IsMemberOf( this->_inspectedClass );
+  }  // StateMachine::IsFieldOfInspectedClass
+
+  bool StateMachine::IsInspectingClass( ) const
+  {
+    return ( this->_currentState == State::CLASSNAME_COLLECTION ) && !this->_classToInspect.empty( )
+           && ( this->_classDetails._name.compare( this->_classToInspect ) == 0 );
+  }  // StateMachine::IsInspectingClass
+
+  std::vector< StateMachine::ClassDetails > StateMachine::GetInspectedClasses( )
+  {
+    if ( !this->_inspectAllClasses ) {
+      return std::vector< ClassDetails >( 1, this->_classDetails );
+    }
+    // the traversal is over, hence so is the last class.
+    this->CloseInspectedClass( );
+    return this->_inspectedClasses;
+  }  // StateMachine::GetInspectedClasses
+
   void StateMachine::ResetAllData( )
   {
     this->_classDetails.clear( );
@@ -278,47 +388,41 @@ namespace RomanoViolet
 
   void StateMachine::ClassDetails::clear( )
   {
-    this->_baseclass.clear( );
-    this->_name.clear( );
-    this->_namespace.clear( );
+    this->_baseclass = StringRef( );
+    this->_name = StringRef( );
+    this->_namespace = StringRef( );
     this->_io.clear( );
   }
 
-  void StateMachine::CollectNamespace( const CXCursor cursor )
+  void StateMachine::CollectNamespace( const Cursor &cursor )
   {
-    if ( this->_classDetails._namespace.empty( ) ) {
-      this->_classDetails._namespace.append( this->toString( clang_getCursorSpelling( cursor ) ) );
-    } else {
-      this->_classDetails._namespace.append(
-          "::" + this->toString( clang_getCursorSpelling( cursor ) ) );
-    }
+    this->_classDetails._namespace = this->Join(
+        this->_classDetails._namespace, cursor.Spelling( this->_strings ) );
   }  // StateMachine::CollectNamespace
 
-  void StateMachine::CollectClassName( const CXCursor cursor )
+  void StateMachine::CollectClassName( const Cursor &cursor )
   {
-    this->_classDetails._name = this->toString( clang_getCursorSpelling( cursor ) );
+    this->_classDetails._name = cursor.Spelling( this->_strings );
   }  // StateMachine::CollectClassName
 
-  void StateMachine::CollectBaseClassName( const CXCursor cursor )
+  void StateMachine::CollectBaseClassName( const Cursor &cursor )
   {
-    const CXType type = clang_getCursorType( cursor );
-    this->_classDetails._baseclass = this->toString( clang_getTypeSpelling( type ) );
+    this->_classDetails._baseclass = cursor.TypeSpelling( this->_strings );
   }  // StateMachine::CollectBaseClassName
 
-  void StateMachine::CollectIOName( const CXCursor cursor )
+  void StateMachine::CollectIOName( const Cursor &cursor )
   {
     // we collect only public facing IO
-    if ( clang_getCXXAccessSpecifier( cursor ) == CX_CXXAccessSpecifier::CX_CXXPublic ) {
+    if ( cursor.Access( ) == CX_CXXAccessSpecifier::CX_CXXPublic ) {
       IODetails _io;
-      _io._ioName = this->toString( clang_getCursorSpelling( cursor ) );
-      const CXType type = clang_getCursorType( cursor );
-      _io._type = this->toString( clang_getTypeSpelling( type ) );
+      _io._ioName = cursor.Spelling( this->_strings );
+      _io._type = cursor.TypeSpelling( this->_strings );
       this->_classDetails._io.emplace_back( _io );
     }
 
   }  // StateMachine::CollectBaseClassName
 
-  void StateMachine::CollectIONameSpace( const CXCursor cursor )
+  void StateMachine::CollectIONameSpace( const Cursor &cursor )
   {
     // Entry to this state is only via IONAME_COLLECTION state wherein an IODetails instance is
     // already created.
@@ -327,14 +431,11 @@ namespace RomanoViolet
 
     // extract the latest instance.
     IODetails &_io = this->_classDetails._io.at( nInstances - 1 );
-    if ( _io._namespace.empty( ) ) {
-      _io._namespace = this->toString( clang_getCursorSpelling( cursor ) );
-    } else {
-      _io._namespace.append( "::" + this->toString( clang_getCursorSpelling( cursor ) ) );
-    }
+    _io._namespace
+        = this->Join( _io._namespace, cursor.Spelling( this->_strings ) );
   }  // StateMachine::CollectIONameSpace
 
-  void StateMachine::CollectIODirection( const CXCursor cursor )
+  void StateMachine::CollectIODirection( const Cursor &cursor )
   {
     // Entry to this state is is only possible by passing through the state IONAME_COLLECTION
     // wherein an IODetails instance is created. already created. number of io instances already
@@ -344,7 +445,7 @@ namespace RomanoViolet
     // extract the latest instance.
     IODetails &_io = this->_classDetails._io.at( nInstances - 1 );
 
-    std::string _ioTemplate = this->toString( clang_getCursorSpelling( cursor ) );
+    const StringRef _ioTemplate = cursor.Spelling( this->_strings );
     if ( _ioTemplate.compare( "TypeInputInterface" ) == 0 ) {
       // Input type
       _io._direction = "In";
@@ -354,7 +455,7 @@ namespace RomanoViolet
   }
   // StateMachine::CollectIODirection
 
-  void StateMachine::CollectIOType( const CXCursor cursor )
+  void StateMachine::CollectIOType( const Cursor &cursor )
   {
     // Entry to this state is is only possible by passing through the state IONAME_COLLECTION
     // wherein an IODetails instance is created. already created. number of io instances already
@@ -364,72 +465,17 @@ namespace RomanoViolet
     // extract the latest instance.
     IODetails &_io = this->_classDetails._io.at( nInstances - 1 );
 
-    const CXType type = clang_getCursorType( cursor );
-    _io._type = this->toString( clang_getTypeSpelling( type ) );
+    _io._type = cursor.TypeSpelling( this->_strings );
   }
   // StateMachine::CollectIOType
 
-  void StateMachine::SortIO( )
-  {
-    std::vector< IODetails > sortedIODetails;
-    for ( auto _io : this->_classDetails._io ) {
-      // all inputs
-      if ( _io._direction.compare( "In" ) == 0 ) {
-        sortedIODetails.emplace_back( _io );
-      }
-
-      // all outputs
-      if ( _io._direction.compare( "Out" ) == 0 ) {
-        sortedIODetails.emplace_back( _io );
-      }
-
-      // no clear input or outputs
-      if ( _io._direction.empty( ) ) {
-        sortedIODetails.emplace_back( _io );
-      }
-    }
-
-    this->_classDetails._io.clear( );
-
-    for ( auto &_io : sortedIODetails ) {
-      this->_classDetails._io.emplace_back( _io );
-    }
-  }
-
-  void StateMachine::print( )
+  void StateMachine::print( std::ostream &out )
   {
-    std::cout << std::left << std::setw( 20 ) << "Class Name: ";
-    std::cout << this->_classDetails._namespace << "::" << this->_classDetails._name << std::endl;
-
-    std::cout << std::left << std::setw( 25 ) << "Base Class: ";
-    std::cout << this->_classDetails._baseclass << std::endl;
-
-    this->SortIO( );
-
-    for ( auto _io : this->_classDetails._io ) {
-      if ( _io._direction.compare( "In" ) == 0 ) {
-        std::cout << std::right << std::setw( 25 ) << "Input: ";
-        std::cout << std::left << std::setw( 15 ) << _io._ioName;
-        std::cout << std::left << std::setw( 7 ) << "Type: " << _io._type;
-        std::cout << std::endl;
-      }
-    }
-    for ( auto _io : this->_classDetails._io ) {
-      if ( _io._direction.compare( "Out" ) == 0 ) {
-        std::cout << std::right << std::setw( 25 ) << "Output: ";
-        std::cout << std::left << std::setw( 15 ) << _io._ioName;
-        std::cout << std::left << std::setw( 7 ) << "Type: " << _io._type;
-        std::cout << std::endl;
-      }
-    }
-
-    for ( auto _io : this->_classDetails._io ) {
-      if ( _io._direction.empty( ) ) {
-        std::cout << std::right << std::setw( 25 ) << "Ambiguous: ";
-        std::cout << std::left << std::setw( 15 ) << _io._ioName;
-        std::cout << std::left << std::setw( 7 ) << "Type: " << _io._type;
-        std::cout << std::endl;
-      }
+    BufferedWriter writer( out );
+    const std::unique_ptr< ResultSink > sink
+        = MakeResultSink( OutputFormat::TEXT, writer, /*labelHeaders=*/false );
+    for ( const ClassDetails &classDetails : this->GetInspectedClasses( ) ) {
+      sink->WriteClass( "", classDetails );
     }
   }
 
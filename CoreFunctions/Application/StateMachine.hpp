@@ -1,21 +1,28 @@
 #ifndef _STATEMACHINE_HPP_
 #define _STATEMACHINE_HPP_
 
+#include "Cursor.hpp"
+#include "StringPool.hpp"
 #include <clang-c/Index.h>
-#include <map>
+#include <iostream>
 #include <string>
 #include <vector>
 namespace RomanoViolet
 {
+  class Instrumentation;
+
   class StateMachine
   {
   public:
     /**
      * @brief Construct a new State Machine object
      *
-     * @param initialClass: The class from AST which is to be examined.
+     * @param initialClass: The class from AST which is to be examined. If empty, the first class
+     * defined in the main file of the translation unit is discovered and examined instead.
+     * @param inspectAllClasses: Examine every class defined at namespace scope in the main file of
+     * the translation unit, in order of appearance. initialClass is ignored.
      */
-    StateMachine( const std::string initialClass );
+    StateMachine( const std::string initialClass, const bool inspectAllClasses = false );
 
     // All possible states of the state machine.
     enum class State : short {
@@ -45,51 +52,79 @@ namespace RomanoViolet
       OTHERS
     };
 
-    void AdvanceStateMachine( const CXCursor cursor );
-    void DoInStateAction( const State currentState, const CXCursor cursor );
-    void print( );
-
-  private:
-    State _currentState;
-    const std::string _classToInspect;
-    void ComputeTransition( const Event event );
-    State GetNewState( const State currentState, const Event event );
-    std::string toString( CXString cxString );
-    void ResetAllData( );
-    void CollectNamespace( const CXCursor cursor );
-    void CollectClassName( const CXCursor cursor );
-    void CollectBaseClassName( const CXCursor cursor );
-    void CollectIOName( const CXCursor cursor );
-    void CollectIONameSpace( const CXCursor cursor );
-    void CollectIODirection( const CXCursor cursor );
-    void CollectIOType( const CXCursor cursor );
-    void SortIO( );
-
+    // The strings refer to the StringPool of the state machine which collected them.
     struct IODetails {
-      std::string _ioName;
-      std::string _type;
-      std::string _direction;
-      std::string _namespace;
+      StringRef _ioName;
+      StringRef _type;
+      StringRef _direction;
+      StringRef _namespace;
     };
 
     struct ClassDetails {
-      std::string _name;
-      std::string _namespace = "";
-      std::string _baseclass;
+      StringRef _name;
+      StringRef _namespace;
+      StringRef _baseclass;
       std::vector< IODetails > _io;
 
       void clear( );
     };
 
-    ClassDetails _classDetails;
+    // The state reached from currentState on event. Pure table lookup, see StateMachine.cpp.
+    static State GetNewState( const State currentState, const Event event );
+
+    void AdvanceStateMachine( const CXCursor cursor );
+    // As above, for a cursor which need not be backed by libclang, e.g., when replaying a log.
+    void AdvanceStateMachine( const Cursor &cursor );
+    void DoInStateAction( const State currentState, const Cursor &cursor );
 
-    // sugar
-    using _currentState_t = State;
-    using _newState_t = State;
+    // Whether AdvanceStateMachine reacts to cursors of kind at all. Others are ignored.
+    static bool IsHandled( const CXCursorKind kind );
+    void print( std::ostream &out = std::cout );
 
-    // ruleset: _currentState >--- Event ----> _newState
-    // Multiple _newStates may be reachable from _currentState based on Events (thus, vector<...>)
-    std::map< _currentState_t, std::vector< std::pair< Event, _newState_t > > > rules;
+    // Whether the class declaration last advanced upon is the one being inspected, i.e., whether
+    // its subtree is of interest.
+    bool IsInspectingClass( ) const;
+
+    // The details collected so far, e.g., for storing them away after the traversal. Holds a
+    // single class unless all classes are inspected. Valid as long as the state machine is.
+    std::vector< ClassDetails > GetInspectedClasses( );
+
+    // Counts the state transitions into instrumentation, if not nullptr.
+    void SetInstrumentation( Instrumentation *instrumentation );
+
+  private:
+    // Owns all strings collected from the translation unit. Spellings which repeat, e.g., type
+    // names, are stored once, and everything is released at once with the state machine.
+    StringPool _strings;
+    // Reused for joining namespaces.
+    std::string _scratch;
+
+    State _currentState;
+    StringRef _classToInspect;
+    bool _discoverClassToInspect;
+    const bool _inspectAllClasses;
+    // In all-classes mode: the class currently examined (null cursor if none), and the ones
+    // already completed.
+    Cursor _inspectedClass;
+    std::vector< ClassDetails > _inspectedClasses;
+    Instrumentation *_instrumentation;
+    void ComputeTransition( const Event event );
+    void Advance( const Cursor &cursor, const CXCursorKind kind );
+    StringRef Join( const StringRef outer, const StringRef inner );
+    void ResetAllData( );
+    void CollectNamespace( const Cursor &cursor );
+    void CollectClassName( const Cursor &cursor );
+    void CollectBaseClassName( const Cursor &cursor );
+    void CollectIOName( const Cursor &cursor );
+    void CollectIONameSpace( const Cursor &cursor );
+    void CollectIODirection( const Cursor &cursor );
+    void CollectIOType( const Cursor &cursor );
+    void DiscoverClassToInspect( const Cursor &cursor );
+    void InspectNextClass( const Cursor &cursor );
+    void CloseInspectedClass( );
+    bool IsFieldOfInspectedClass( const Cursor &cursor );
+
+    ClassDetails _classDetails;
 
   };  // class StateMachine;
 }  // namespace RomanoViolet
@@ -0,0 +1,74 @@
+#include "StringPool.hpp"
+#include <algorithm>
+#include <cstdint>
+namespace RomanoViolet
+{
+  int StringRef::compare( StringRef other ) const
+  {
+    const int result = std::memcmp( this->_data, other._data, std::min( this->_size, other._size ) );
+    if ( result != 0 ) {
+      return result;
+    }
+    return ( this->_size < other._size ) ? -1 : ( ( this->_size > other._size ) ? 1 : 0 );
+  }  // StringRef::compare
+
+  std::size_t StringPool::Hash::operator( )( StringRef string ) const
+  {
+    // 64-bit FNV-1a
+    std::uint64_t hash = 14695981039346656037ULL;
+    for ( const char character : string ) {
+      hash ^= static_cast< unsigned char >( character );
+      hash *= 1099511628211ULL;
+    }
+    return static_cast< std::size_t >( hash );
+  }  // StringPool::Hash::operator()
+
+  StringPool::StringPool( std::size_t blockSize )
+      : _strings( ), _blocks( ), _blockSize( blockSize ), _next( nullptr ), _available( 0 )
+  {
+  }
+
+  char *StringPool::Allocate( std::size_t size )
+  {
+    if ( size > this->_available ) {
+      // strings longer than a block get a block of their own.
+      const std::size_t blockSize = std::max( size, this->_blockSize );
+      this->_blocks.emplace_back( new char[blockSize] );
+      this->_next = this->_blocks.back( ).get( );
+      this->_available = blockSize;
+    }
+    char *allocated = this->_next;
+    this->_next += size;
+    this->_available -= size;
+    return allocated;
+  }  // StringPool::Allocate
+
+  StringRef StringPool::Intern( StringRef string )
+  {
+    if ( string.empty( ) ) {
+      return StringRef( );
+    }
+
+    const auto known = this->_strings.find( string );
+    if ( known != this->_strings.end( ) ) {
+      return *known;
+    }
+
+    // null-terminated, so that interned strings can be handed to C APIs as well.
+    char *copy = this->Allocate( string.size( ) + 1 );
+    std::memcpy( copy, string.data( ), string.size( ) );
+    copy[string.size( )] = '\0';
+
+    const StringRef interned( copy, string.size( ) );
+    this->_strings.insert( interned );
+    return interned;
+  }  // StringPool::Intern
+
+  StringRef StringPool::Intern( CXString cxString )
+  {
+    const char *string = clang_getCString( cxString );
+    const StringRef interned = this->Intern( ( string == nullptr ) ? StringRef( ) : StringRef( string ) );
+    clang_disposeString( cxString );
+    return interned;
+  }  // StringPool::Intern
+}  // namespace RomanoViolet
@@ -0,0 +1,123 @@
+#ifndef _STRINGPOOL_HPP_
+#define _STRINGPOOL_HPP_
+
+#include <clang-c/Index.h>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Non-owning reference to a string, e.g., to one interned in a StringPool. Cheap to copy
+   * and compare; the referenced characters must outlive the reference.
+   */
+  class StringRef
+  {
+  public:
+    StringRef( ) : _data( "" ), _size( 0 )
+    {
+    }
+
+    // Not explicit: intended for string literals.
+    StringRef( const char *string ) : _data( string ), _size( std::strlen( string ) )
+    {
+    }
+
+    StringRef( const char *data, std::size_t size ) : _data( data ), _size( size )
+    {
+    }
+
+    // Explicit: a reference to a temporary std::string would dangle.
+    explicit StringRef( const std::string &string ) : _data( string.data( ) ), _size( string.size( ) )
+    {
+    }
+
+    const char *data( ) const
+    {
+      return this->_data;
+    }
+
+    std::size_t size( ) const
+    {
+      return this->_size;
+    }
+
+    bool empty( ) const
+    {
+      return this->_size == 0;
+    }
+
+    const char *begin( ) const
+    {
+      return this->_data;
+    }
+
+    const char *end( ) const
+    {
+      return this->_data + this->_size;
+    }
+
+    std::string str( ) const
+    {
+      return std::string( this->_data, this->_size );
+    }
+
+    int compare( StringRef other ) const;
+
+  private:
+    const char *_data;
+    std::size_t _size;
+  };  // class StringRef
+
+  inline bool operator==( StringRef left, StringRef right )
+  {
+    return left.compare( right ) == 0;
+  }
+
+  inline bool operator!=( StringRef left, StringRef right )
+  {
+    return left.compare( right ) != 0;
+  }
+
+  inline std::ostream &operator<<( std::ostream &out, StringRef string )
+  {
+    return out.write( string.data( ), string.size( ) );
+  }
+
+  /**
+   * @brief Interning table backed by an arena.
+   * @details Every distinct string is stored once, in large blocks which are only released, all at
+   * once, when the pool is destroyed. Looking up a string which was interned before, e.g., a type
+   * name such as RomanoViolet::InterfaceB, does not allocate. References handed out remain valid
+   * for the lifetime of the pool.
+   */
+  class StringPool
+  {
+  public:
+    explicit StringPool( std::size_t blockSize = 16 * 1024 );
+    StringPool( const StringPool & ) = delete;
+    StringPool &operator=( const StringPool & ) = delete;
+
+    StringRef Intern( StringRef string );
+
+    // Interns the string, and disposes cxString.
+    StringRef Intern( CXString cxString );
+
+  private:
+    struct Hash {
+      std::size_t operator( )( StringRef string ) const;
+    };
+
+    std::unordered_set< StringRef, Hash > _strings;
+    std::vector< std::unique_ptr< char[] > > _blocks;
+    const std::size_t _blockSize;
+    char *_next;
+    std::size_t _available;
+
+    char *Allocate( std::size_t size );
+  };  // class StringPool
+}  // namespace RomanoViolet
+#endif  // !_STRINGPOOL_HPP_
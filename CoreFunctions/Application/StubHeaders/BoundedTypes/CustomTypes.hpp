@@ -0,0 +1,10 @@
+#ifndef CUSTOM_TYPES_HPP_
+#define CUSTOM_TYPES_HPP_
+
+// Stub of BoundedTypes/CustomTypes.hpp, used with --stub-includes. The aliases are the real ones.
+#include "SafeTypes.hpp"
+
+using VelocityType = RomanoViolet::SafeType< Fraction( 1, 2 ), Fraction( 3, 4 ) >;
+using CountingType = RomanoViolet::SafeType< 1, 4 >;
+
+#endif  // !CUSTOM_TYPES_HPP_
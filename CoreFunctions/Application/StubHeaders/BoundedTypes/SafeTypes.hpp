@@ -0,0 +1,25 @@
+#ifndef SAFETYPES_HPP_
+#define SAFETYPES_HPP_
+
+// Stub of BoundedTypes/SafeTypes.hpp, used with --stub-includes. Neither <cassert> nor <cstdint>
+// is included, and the bounds are not checked.
+#include "SafeTypesStorage.hpp"
+namespace RomanoViolet
+{
+  enum class SafeTypeErrorCode : unsigned char { NO_ERROR = 0U, UNDERFLOW = 1U, OVERFLOW = 2U };
+
+  template < int NumeratorForMinBound = 1,
+             int DenominatorForMinBound = 1,
+             int NumeratorForMaxBound = 1,
+             int DenominatorForMaxBound = 1,
+             typename StoragePolicy = FloatStorage >
+  class SafeType
+  {
+  public:
+    SafeType( float value );
+  };
+}  // namespace RomanoViolet
+
+#define Fraction( a, b ) a, b
+
+#endif  // !SAFETYPES_HPP_
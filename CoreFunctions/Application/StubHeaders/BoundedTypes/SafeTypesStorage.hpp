@@ -0,0 +1,18 @@
+#ifndef SAFETYPES_STORAGE_HPP_
+#define SAFETYPES_STORAGE_HPP_
+
+// Stub of BoundedTypes/SafeTypesStorage.hpp, used with --stub-includes: the storage policies,
+// without the integer selection, which needs <cstdint>, <limits> and <type_traits>.
+namespace RomanoViolet
+{
+  struct FloatStorage {
+  };
+
+  template < int Scale >
+  struct FixedPointStorage {
+  };
+
+  using IntegerStorage = FixedPointStorage< 1 >;
+}  // namespace RomanoViolet
+
+#endif  // !SAFETYPES_STORAGE_HPP_
@@ -0,0 +1,15 @@
+#ifndef INTERFACE_A_HPP_
+#define INTERFACE_A_HPP_
+
+// Stub of Library/InterfaceTypes/InterfaceA.hpp, used with --stub-includes. The bounded members
+// are left out, so that BoundedTypes/ is not included.
+namespace RomanoViolet
+{
+  class InterfaceA
+  {
+  public:
+    InterfaceA( ) = default;
+  };
+}  // namespace RomanoViolet
+
+#endif  // INTERFACE_A_HPP_
@@ -0,0 +1,15 @@
+#ifndef INTERFACE_B_HPP_
+#define INTERFACE_B_HPP_
+
+// Stub of Library/InterfaceTypes/InterfaceB.hpp, used with --stub-includes. The bounded members
+// are left out, so that BoundedTypes/ is not included.
+namespace RomanoViolet
+{
+  class InterfaceB
+  {
+  public:
+    InterfaceB( ) = default;
+  };
+}  // namespace RomanoViolet
+
+#endif  // INTERFACE_B_HPP_
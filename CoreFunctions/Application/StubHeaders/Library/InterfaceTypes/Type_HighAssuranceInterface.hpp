@@ -0,0 +1,16 @@
+#ifndef TYPE_HIGH_ASSURNACE_INTERFACE
+#define TYPE_HIGH_ASSURNACE_INTERFACE
+
+// Stub of Library/InterfaceTypes/Type_HighAssuranceInterface.hpp, used with --stub-includes.
+namespace RomanoViolet
+{
+  class TypeHighAssuranceInterface
+  {
+  public:
+    TypeHighAssuranceInterface( ) = default;
+    virtual void doPreconditionCheck( ) = 0;
+    virtual ~TypeHighAssuranceInterface( ) = default;
+  };
+}  // namespace RomanoViolet
+
+#endif  // TYPE_HIGH_ASSURNACE_INTERFACE
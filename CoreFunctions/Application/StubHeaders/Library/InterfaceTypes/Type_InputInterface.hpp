@@ -0,0 +1,16 @@
+#ifndef TYPE_INPUT_INTERFACE_HPP_
+#define TYPE_INPUT_INTERFACE_HPP_
+
+// Stub of Library/InterfaceTypes/Type_InputInterface.hpp, used with --stub-includes. Declarations
+// only: the definitions in Type_InputInterface.inl are not included.
+namespace RomanoViolet
+{
+  template < typename T >
+  class TypeInputInterface
+  {
+  public:
+    TypeInputInterface( ) = default;
+  };
+}  // namespace RomanoViolet
+
+#endif  // TYPE_INPUT_INTERFACE_HPP_
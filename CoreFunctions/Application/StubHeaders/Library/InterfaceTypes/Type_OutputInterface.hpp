@@ -0,0 +1,16 @@
+#ifndef TYPE_OUTPUT_INTERFACE_HPP_
+#define TYPE_OUTPUT_INTERFACE_HPP_
+
+// Stub of Library/InterfaceTypes/Type_OutputInterface.hpp, used with --stub-includes. Declarations
+// only: the definitions in Type_OutputInterface.inl are not included.
+namespace RomanoViolet
+{
+  template < typename T >
+  class TypeOutputInterface
+  {
+  public:
+    TypeOutputInterface( ) = default;
+  };
+}  // namespace RomanoViolet
+
+#endif  // TYPE_OUTPUT_INTERFACE_HPP_
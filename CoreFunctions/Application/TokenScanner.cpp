@@ -0,0 +1,665 @@
+#include "TokenScanner.hpp"
+#include "StateMachine.hpp"
+#include <cstring>
+namespace RomanoViolet
+{
+  namespace
+  {
+    // Keywords which make up builtin types. None of them is ever referred to by a cursor.
+    const char *const builtinKeywords[] = { "void",   "bool",     "char",     "short",   "int",
+                                            "long",   "float",    "double",   "signed",  "unsigned",
+                                            "wchar_t", "char16_t", "char32_t" };
+    // Builtin types libclang spells as written, given a single keyword.
+    const char *const canonicalBuiltins[] = { "bool",  "char",   "short",   "int",     "long",
+                                              "float", "double", "wchar_t", "char16_t", "char32_t" };
+
+    // The templates of the IO convention, see StateMachine::CollectIODirection.
+    const char *const interfaceTemplates[] = { "TypeInputInterface", "TypeOutputInterface" };
+
+    template < std::size_t N >
+    bool isOneOf( const StringRef spelling, const char *const ( &candidates )[N] )
+    {
+      for ( const char *candidate : candidates ) {
+        if ( spelling.compare( candidate ) == 0 ) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    CursorEvent makeEvent( const CXCursorKind kind,
+                           const StringRef spelling,
+                           const StringRef typeSpelling )
+    {
+      CursorEvent event;
+      event._kind = kind;
+      event._spelling = spelling;
+      event._typeSpelling = typeSpelling;
+      event._isFromMainFile = true;
+      return event;
+    }
+  }  // namespace
+
+  TokenScanner::TokenScanner( CXTranslationUnit tu )
+      : _strings( )
+      , _tokens( )
+      , _position( 0 )
+      , _lineOfFailure( 0 )
+      , _declarations( )
+      , _namespaces( )
+      , _numberOfClasses( 0 )
+      , _scratch( )
+  {
+    // the extent of the translation unit is the main file.
+    CXToken *tokens = nullptr;
+    unsigned numberOfTokens = 0;
+    clang_tokenize(
+        tu, clang_getCursorExtent( clang_getTranslationUnitCursor( tu ) ), &tokens, &numberOfTokens );
+    this->_tokens.reserve( numberOfTokens );
+    for ( unsigned i = 0; i < numberOfTokens; ++i ) {
+      Token token;
+      token._kind = clang_getTokenKind( tokens[i] );
+      // e.g., documentation comments.
+      if ( token._kind == CXTokenKind::CXToken_Comment ) {
+        continue;
+      }
+      token._spelling = this->_strings.Intern( clang_getTokenSpelling( tu, tokens[i] ) );
+      clang_getSpellingLocation(
+          clang_getTokenLocation( tu, tokens[i] ), nullptr, &token._line, nullptr, nullptr );
+      this->_tokens.emplace_back( token );
+    }
+    clang_disposeTokens( tu, tokens, numberOfTokens );
+  }
+
+  bool TokenScanner::Scan( const bool allClasses )
+  {
+    if ( !this->ScanDirectives( ) ) {
+      return false;
+    }
+
+    bool isDone = false;
+    if ( !this->ScanNamespaceScope( allClasses, isDone ) ) {
+      return false;
+    }
+    // e.g., a stray closing brace.
+    if ( !isDone && ( this->_position < this->_tokens.size( ) ) ) {
+      return this->Fail( );
+    }
+
+    // namespaces still open once the class of interest is done end with the header.
+    for ( Declaration &declaration : this->_declarations ) {
+      if ( ( declaration._kind == Declaration::Kind::NAMESPACE ) && ( declaration._end == 0 ) ) {
+        declaration._end = this->_declarations.size( );
+      }
+    }
+    return true;
+  }  // TokenScanner::Scan
+
+  unsigned TokenScanner::GetLineOfFailure( ) const
+  {
+    return this->_lineOfFailure;
+  }
+
+  std::size_t TokenScanner::GetNumberOfTokens( ) const
+  {
+    return this->_tokens.size( );
+  }
+
+  StringRef TokenScanner::GetFirstClass( ) const
+  {
+    for ( const Declaration &declaration : this->_declarations ) {
+      if ( declaration._kind == Declaration::Kind::CLASS ) {
+        return declaration._event._spelling;
+      }
+    }
+    return StringRef( );
+  }  // TokenScanner::GetFirstClass
+
+  StringRef TokenScanner::GetFirstClassNamespaces( ) const
+  {
+    for ( const Declaration &declaration : this->_declarations ) {
+      if ( declaration._kind == Declaration::Kind::CLASS ) {
+        return declaration._event._enclosingNamespaces;
+      }
+    }
+    return StringRef( );
+  }  // TokenScanner::GetFirstClassNamespaces
+
+  void TokenScanner::Feed( StateMachine &stateMachine,
+                           const std::string &namespaceToInspect,
+                           const bool allClasses ) const
+  {
+    // mirrors visit( ) in ParseHeader.cpp.
+    for ( std::size_t i = 0; i < this->_declarations.size( ); ++i ) {
+      const Declaration &declaration = this->_declarations[i];
+      switch ( declaration._kind ) {
+        case Declaration::Kind::NAMESPACE: {
+          const std::string name = declaration._qualifiedName.str( );
+          if ( !namespaceToInspect.empty( ) && ( namespaceToInspect.compare( name ) != 0 )
+               && ( namespaceToInspect.compare( 0, name.size( ) + 2, name + "::" ) != 0 ) ) {
+            i = declaration._end;
+            break;
+          }
+          stateMachine.AdvanceStateMachine( Cursor( declaration._event ) );
+          break;
+        }
+
+        case Declaration::Kind::CLASS: {
+          stateMachine.AdvanceStateMachine( Cursor( declaration._event ) );
+          if ( !stateMachine.IsInspectingClass( ) ) {
+            break;
+          }
+          for ( const CursorEvent &member : declaration._members ) {
+            stateMachine.AdvanceStateMachine( Cursor( member ) );
+          }
+          if ( !allClasses ) {
+            return;
+          }
+          break;
+        }
+
+        default:
+          break;
+      }
+    }
+  }  // TokenScanner::Feed
+
+  const TokenScanner::Token &TokenScanner::Peek( const std::size_t offset ) const
+  {
+    static const Token end = { CXTokenKind::CXToken_Punctuation, StringRef( ), 0 };
+    const std::size_t position = this->_position + offset;
+    return ( position < this->_tokens.size( ) ) ? this->_tokens[position] : end;
+  }
+
+  bool TokenScanner::IsAt( const char *spelling, const std::size_t offset ) const
+  {
+    return this->Peek( offset )._spelling.compare( spelling ) == 0;
+  }
+
+  bool TokenScanner::IsIdentifierAt( const std::size_t offset ) const
+  {
+    return this->Peek( offset )._kind == CXTokenKind::CXToken_Identifier;
+  }
+
+  bool TokenScanner::Accept( const char *spelling )
+  {
+    if ( !this->IsAt( spelling ) ) {
+      return false;
+    }
+    ++this->_position;
+    return true;
+  }
+
+  bool TokenScanner::Fail( )
+  {
+    if ( this->_position < this->_tokens.size( ) ) {
+      this->_lineOfFailure = this->_tokens[this->_position]._line;
+    } else {
+      this->_lineOfFailure = this->_tokens.empty( ) ? 1 : this->_tokens.back( )._line;
+    }
+    return false;
+  }  // TokenScanner::Fail
+
+  bool TokenScanner::ScanDirectives( )
+  {
+    // Directives are dropped from the tokens. Only those which cannot change what the remainder
+    // means are accepted: includes, pragmas and an include guard.
+    std::vector< Token > code;
+    code.reserve( this->_tokens.size( ) );
+    std::size_t numberOfDirectives = 0;
+    StringRef guard;
+    for ( std::size_t i = 0; i < this->_tokens.size( ); ) {
+      const Token &token = this->_tokens[i];
+      const bool isAtLineStart = ( i == 0 ) || ( this->_tokens[i - 1]._line != token._line );
+      if ( !isAtLineStart || ( token._spelling.compare( "#" ) != 0 ) ) {
+        code.emplace_back( token );
+        ++i;
+        continue;
+      }
+
+      std::size_t end = i + 1;
+      while ( ( end < this->_tokens.size( ) ) && ( this->_tokens[end]._line == token._line ) ) {
+        ++end;
+      }
+      const StringRef directive = ( i + 1 < end ) ? this->_tokens[i + 1]._spelling : StringRef( );
+      const StringRef name = ( i + 2 < end ) ? this->_tokens[i + 2]._spelling : StringRef( );
+      bool isAccepted = ( directive.compare( "include" ) == 0 )
+                        || ( directive.compare( "pragma" ) == 0 )
+                        || ( directive.compare( "endif" ) == 0 );
+      if ( ( directive.compare( "ifndef" ) == 0 ) && ( numberOfDirectives == 0 ) ) {
+        guard = name;
+        isAccepted = true;
+      } else if ( ( directive.compare( "define" ) == 0 ) && ( numberOfDirectives == 1 )
+                  && !guard.empty( ) && ( name == guard ) && ( end == i + 3 ) ) {
+        isAccepted = true;
+      }
+      if ( !isAccepted ) {
+        this->_lineOfFailure = token._line;
+        return false;
+      }
+      ++numberOfDirectives;
+      i = end;
+    }
+    this->_tokens.swap( code );
+    return true;
+  }  // TokenScanner::ScanDirectives
+
+  bool TokenScanner::ScanNamespaceScope( const bool allClasses, bool &isDone )
+  {
+    while ( ( this->_position < this->_tokens.size( ) ) && !this->IsAt( "}" ) ) {
+      if ( this->Accept( ";" ) ) {
+        continue;
+      }
+
+      if ( this->IsAt( "namespace" ) && this->IsIdentifierAt( 1 ) && this->IsAt( "{", 2 ) ) {
+        const StringRef name = this->Peek( 1 )._spelling;
+        this->_position += 3;
+
+        Declaration declaration;
+        declaration._kind = Declaration::Kind::NAMESPACE;
+        declaration._event = makeEvent( CXCursorKind::CXCursor_Namespace, name, StringRef( ) );
+        declaration._event._isDefinition = true;
+        declaration._event._isAtNamespaceScope = true;
+        declaration._qualifiedName = this->Qualify( name );
+        declaration._end = 0;
+        const std::size_t index = this->_declarations.size( );
+        this->_declarations.emplace_back( declaration );
+
+        this->_namespaces.emplace_back( name );
+        if ( !this->ScanNamespaceScope( allClasses, isDone ) ) {
+          return false;
+        }
+        if ( isDone ) {
+          return true;
+        }
+        if ( !this->Accept( "}" ) ) {
+          return this->Fail( );
+        }
+        this->_namespaces.pop_back( );
+
+        this->_declarations[index]._end = this->_declarations.size( );
+        Declaration end;
+        end._kind = Declaration::Kind::NAMESPACE_END;
+        end._end = 0;
+        this->_declarations.emplace_back( end );
+        continue;
+      }
+
+      if ( this->IsAt( "class" ) ) {
+        if ( !this->ScanClass( ) ) {
+          return false;
+        }
+        if ( !allClasses ) {
+          isDone = true;
+          return true;
+        }
+        continue;
+      }
+
+      // e.g., a struct, a template, a function, or a forward declaration.
+      return this->Fail( );
+    }
+    return true;
+  }  // TokenScanner::ScanNamespaceScope
+
+  bool TokenScanner::ScanClass( )
+  {
+    // class Name [final] : [access] Base { members };
+    ++this->_position;
+    if ( !this->IsIdentifierAt( ) ) {
+      return this->Fail( );
+    }
+    const StringRef name = this->Peek( )._spelling;
+    ++this->_position;
+    this->Accept( "final" );
+
+    // a class without a base, e.g., a forward declaration, is not a component. Nor is one with
+    // several bases, or with a base which is looked up in a scope the scan does not know of.
+    if ( !this->Accept( ":" ) ) {
+      return this->Fail( );
+    }
+    CX_CXXAccessSpecifier baseAccess = CX_CXXAccessSpecifier::CX_CXXPrivate;
+    if ( this->Accept( "public" ) ) {
+      baseAccess = CX_CXXAccessSpecifier::CX_CXXPublic;
+    } else if ( this->Accept( "protected" ) ) {
+      baseAccess = CX_CXXAccessSpecifier::CX_CXXProtected;
+    } else if ( this->Accept( "private" ) ) {
+      baseAccess = CX_CXXAccessSpecifier::CX_CXXPrivate;
+    }
+    if ( !this->IsIdentifierAt( ) || !this->IsAt( "{", 1 ) ) {
+      return this->Fail( );
+    }
+    const StringRef base = this->Peek( )._spelling;
+    this->_position += 2;
+
+    Declaration declaration;
+    declaration._kind = Declaration::Kind::CLASS;
+    declaration._event
+        = makeEvent( CXCursorKind::CXCursor_ClassDecl, name, this->Qualify( name ) );
+    declaration._event._isDefinition = true;
+    declaration._event._isAtNamespaceScope = true;
+    declaration._event._enclosingNamespaces = this->Join( this->_namespaces, this->_namespaces.size( ) );
+    declaration._event._id = ++this->_numberOfClasses;
+    declaration._end = 0;
+
+    CursorEvent baseSpecifier = makeEvent( CXCursorKind::CXCursor_CXXBaseSpecifier, base, base );
+    baseSpecifier._access = baseAccess;
+    declaration._members.emplace_back( baseSpecifier );
+    declaration._members.emplace_back( makeEvent( CXCursorKind::CXCursor_TypeRef, base, base ) );
+
+    CX_CXXAccessSpecifier access = CX_CXXAccessSpecifier::CX_CXXPrivate;
+    while ( !this->IsAt( "}" ) ) {
+      if ( ( this->_position >= this->_tokens.size( ) ) || !this->ScanMember( declaration, access ) ) {
+        return this->Fail( );
+      }
+    }
+    ++this->_position;
+    if ( !this->Accept( ";" ) ) {
+      return this->Fail( );
+    }
+    this->_declarations.emplace_back( declaration );
+    return true;
+  }  // TokenScanner::ScanClass
+
+  bool TokenScanner::ScanMember( Declaration &scope, CX_CXXAccessSpecifier &access )
+  {
+    if ( this->IsAt( ":", 1 ) ) {
+      if ( this->Accept( "public" ) ) {
+        access = CX_CXXAccessSpecifier::CX_CXXPublic;
+      } else if ( this->Accept( "protected" ) ) {
+        access = CX_CXXAccessSpecifier::CX_CXXProtected;
+      } else if ( this->Accept( "private" ) ) {
+        access = CX_CXXAccessSpecifier::CX_CXXPrivate;
+      } else {
+        return false;
+      }
+      ++this->_position;
+      return true;
+    }
+    if ( this->Accept( ";" ) ) {
+      return true;
+    }
+    if ( this->IsAt( "enum" ) ) {
+      return this->ScanEnum( );
+    }
+
+    bool hasSpecifiers = false;
+    while ( this->Accept( "virtual" ) || this->Accept( "explicit" ) || this->Accept( "inline" ) ) {
+      hasSpecifiers = true;
+    }
+
+    // the cursors of constructors and methods are of no interest, but the references in the types
+    // of their parameters and results are.
+    const StringRef className = scope._event._spelling;
+    if ( this->Accept( "~" ) ) {
+      if ( !this->IsAt( className.data( ) ) ) {
+        return false;
+      }
+      ++this->_position;
+      return this->ScanParameters( scope._members ) && this->ScanFunctionTail( false );
+    }
+    if ( this->IsAt( className.data( ) ) && this->IsAt( "(", 1 ) ) {
+      ++this->_position;
+      return this->ScanParameters( scope._members ) && this->ScanFunctionTail( true );
+    }
+
+    std::vector< CursorEvent > references;
+    StringRef type;
+    bool isSpellingKnown;
+    if ( !this->ScanType( references, type, isSpellingKnown ) ) {
+      return false;
+    }
+    bool isIndirect = false;
+    while ( this->Accept( "*" ) || this->Accept( "&" ) || this->Accept( "&&" )
+            || this->Accept( "const" ) ) {
+      isIndirect = true;
+    }
+    if ( !this->IsIdentifierAt( ) || this->IsAt( "operator" ) ) {
+      return false;
+    }
+    const StringRef name = this->Peek( )._spelling;
+    ++this->_position;
+
+    if ( this->IsAt( "(" ) ) {
+      scope._members.insert( scope._members.end( ), references.begin( ), references.end( ) );
+      return this->ScanParameters( scope._members ) && this->ScanFunctionTail( false );
+    }
+
+    // A field. The type of a public one becomes the type of the IO, unless a reference in it
+    // overrides it, see StateMachine::CollectIOType.
+    if ( !this->Accept( ";" ) || hasSpecifiers || isIndirect
+         || ( ( access == CX_CXXAccessSpecifier::CX_CXXPublic ) && !isSpellingKnown ) ) {
+      return false;
+    }
+    CursorEvent field = makeEvent( CXCursorKind::CXCursor_FieldDecl, name, type );
+    field._access = access;
+    field._isDefinition = true;
+    field._parent = scope._event._id;
+    scope._members.emplace_back( field );
+    scope._members.insert( scope._members.end( ), references.begin( ), references.end( ) );
+    return true;
+  }  // TokenScanner::ScanMember
+
+  bool TokenScanner::ScanEnum( )
+  {
+    // enum [class] [Name] [: builtin] { enumerators };
+    ++this->_position;
+    if ( !this->Accept( "class" ) ) {
+      this->Accept( "struct" );
+    }
+    if ( this->IsIdentifierAt( ) ) {
+      ++this->_position;
+    }
+    if ( this->Accept( ":" ) ) {
+      if ( !isOneOf( this->Peek( )._spelling, builtinKeywords ) ) {
+        return false;
+      }
+      while ( isOneOf( this->Peek( )._spelling, builtinKeywords ) ) {
+        ++this->_position;
+      }
+    }
+    if ( !this->Accept( "{" ) ) {
+      return false;
+    }
+
+    // initializers refer to enumerators and literals only: a type, e.g., in a cast, would be
+    // referred to by a cursor.
+    const char *const operators[] = { "=", ",", "-", "+", "|", "&", "<<", "~" };
+    while ( !this->Accept( "}" ) ) {
+      const Token &token = this->Peek( );
+      const bool isAccepted = ( token._kind == CXTokenKind::CXToken_Identifier )
+                              || ( token._kind == CXTokenKind::CXToken_Literal )
+                              || ( ( token._kind == CXTokenKind::CXToken_Punctuation )
+                                   && isOneOf( token._spelling, operators ) );
+      if ( !isAccepted ) {
+        return false;
+      }
+      ++this->_position;
+    }
+    return this->Accept( ";" );
+  }  // TokenScanner::ScanEnum
+
+  bool TokenScanner::ScanType( std::vector< CursorEvent > &events,
+                               StringRef &spelling,
+                               bool &isSpellingKnown )
+  {
+    // builtin, e.g., unsigned int.
+    if ( isOneOf( this->Peek( )._spelling, builtinKeywords ) ) {
+      const StringRef first = this->Peek( )._spelling;
+      this->_scratch.clear( );
+      std::size_t numberOfKeywords = 0;
+      while ( isOneOf( this->Peek( )._spelling, builtinKeywords ) ) {
+        this->_scratch.append( this->_scratch.empty( ) ? "" : " " );
+        this->_scratch.append( this->Peek( )._spelling.data( ), this->Peek( )._spelling.size( ) );
+        ++this->_position;
+        ++numberOfKeywords;
+      }
+      spelling = this->_strings.Intern( StringRef( this->_scratch ) );
+      isSpellingKnown = ( numberOfKeywords == 1 ) && isOneOf( first, canonicalBuiltins );
+      return true;
+    }
+
+    // [::]A::B::Name, or [::]A::B::Name< ::C::D::Argument > for the IO templates.
+    const bool isAbsolute = this->Accept( "::" );
+    std::vector< StringRef > names;
+    while ( this->IsIdentifierAt( ) ) {
+      names.emplace_back( this->Peek( )._spelling );
+      ++this->_position;
+      if ( !this->IsAt( "::" ) || !this->IsIdentifierAt( 1 ) ) {
+        break;
+      }
+      ++this->_position;
+    }
+    // a relative qualifier is looked up in a scope the scan does not know of.
+    if ( names.empty( ) || ( !isAbsolute && ( names.size( ) > 1 ) ) ) {
+      return false;
+    }
+    for ( std::size_t i = 0; i + 1 < names.size( ); ++i ) {
+      events.emplace_back(
+          makeEvent( CXCursorKind::CXCursor_NamespaceRef, names[i], StringRef( ) ) );
+    }
+    const bool isTemplate = isOneOf( names.back( ), interfaceTemplates );
+    if ( isTemplate != this->IsAt( "<" ) ) {
+      return false;
+    }
+
+    if ( !isTemplate ) {
+      // the type referred to is spelled by its qualified name, known for absolute names only.
+      const StringRef qualifiedName = this->Join( names, names.size( ) );
+      events.emplace_back(
+          makeEvent( CXCursorKind::CXCursor_TypeRef, qualifiedName, qualifiedName ) );
+      this->_scratch.assign( isAbsolute ? "::" : "" );
+      this->_scratch.append( qualifiedName.data( ), qualifiedName.size( ) );
+      spelling = this->_strings.Intern( StringRef( this->_scratch ) );
+      isSpellingKnown = isAbsolute;
+      return true;
+    }
+
+    // the argument decides the type of the IO, hence must be absolute.
+    events.emplace_back(
+        makeEvent( CXCursorKind::CXCursor_TemplateRef, names.back( ), StringRef( ) ) );
+    ++this->_position;
+    if ( !this->Accept( "::" ) ) {
+      return false;
+    }
+    std::vector< StringRef > argument;
+    while ( this->IsIdentifierAt( ) ) {
+      argument.emplace_back( this->Peek( )._spelling );
+      ++this->_position;
+      if ( !this->Accept( "::" ) ) {
+        break;
+      }
+    }
+    if ( argument.empty( ) || !this->Accept( ">" ) ) {
+      return false;
+    }
+    for ( std::size_t i = 0; i + 1 < argument.size( ); ++i ) {
+      events.emplace_back(
+          makeEvent( CXCursorKind::CXCursor_NamespaceRef, argument[i], StringRef( ) ) );
+    }
+    const StringRef argumentName = this->Join( argument, argument.size( ) );
+    events.emplace_back( makeEvent( CXCursorKind::CXCursor_TypeRef, argumentName, argumentName ) );
+
+    // as printed by libclang, e.g., ::RomanoViolet::TypeInputInterface< ::RomanoViolet::InterfaceA>
+    const StringRef templateName = this->Join( names, names.size( ) );
+    this->_scratch.assign( isAbsolute ? "::" : "" );
+    this->_scratch.append( templateName.data( ), templateName.size( ) );
+    this->_scratch.append( "< ::" );
+    this->_scratch.append( argumentName.data( ), argumentName.size( ) );
+    this->_scratch.append( ">" );
+    spelling = this->_strings.Intern( StringRef( this->_scratch ) );
+    isSpellingKnown = true;
+    return true;
+  }  // TokenScanner::ScanType
+
+  bool TokenScanner::ScanParameters( std::vector< CursorEvent > &events )
+  {
+    if ( !this->Accept( "(" ) ) {
+      return false;
+    }
+    if ( this->Accept( ")" ) || ( this->IsAt( "void" ) && this->IsAt( ")", 1 ) && this->Accept( "void" )
+                                  && this->Accept( ")" ) ) ) {
+      return true;
+    }
+    do {
+      // [const] type [const] [*|&]... [name], without a default argument.
+      this->Accept( "const" );
+      StringRef type;
+      bool isSpellingKnown;
+      if ( !this->ScanType( events, type, isSpellingKnown ) ) {
+        return false;
+      }
+      while ( this->Accept( "*" ) || this->Accept( "&" ) || this->Accept( "&&" )
+              || this->Accept( "const" ) ) {
+      }
+      if ( this->IsIdentifierAt( ) ) {
+        ++this->_position;
+      }
+    } while ( this->Accept( "," ) );
+    return this->Accept( ")" );
+  }  // TokenScanner::ScanParameters
+
+  bool TokenScanner::ScanFunctionTail( const bool isConstructor )
+  {
+    while ( this->Accept( "const" ) || this->Accept( "override" ) || this->Accept( "final" )
+            || ( this->IsAt( "noexcept" ) && !this->IsAt( "(", 1 ) && this->Accept( "noexcept" ) ) ) {
+    }
+    if ( this->Accept( ";" ) ) {
+      return true;
+    }
+    if ( this->Accept( "=" ) ) {
+      return ( this->Accept( "0" ) || this->Accept( "default" ) || this->Accept( "delete" ) )
+             && this->Accept( ";" );
+    }
+
+    // Bodies, and with them member initializers, are skipped by the parse
+    // (CXTranslationUnit_SkipFunctionBodies): no cursor refers to anything in there.
+    if ( isConstructor && this->Accept( ":" ) ) {
+      do {
+        this->Accept( "::" );
+        while ( this->IsIdentifierAt( ) || this->IsAt( "::" ) ) {
+          ++this->_position;
+        }
+        if ( !( this->IsAt( "(" ) ? this->SkipBalanced( "(", ")" )
+                                  : this->SkipBalanced( "{", "}" ) ) ) {
+          return false;
+        }
+      } while ( this->Accept( "," ) );
+    }
+    return this->IsAt( "{" ) && this->SkipBalanced( "{", "}" );
+  }  // TokenScanner::ScanFunctionTail
+
+  bool TokenScanner::SkipBalanced( const char *open, const char *close )
+  {
+    if ( !this->Accept( open ) ) {
+      return false;
+    }
+    std::size_t depth = 1;
+    while ( ( depth > 0 ) && ( this->_position < this->_tokens.size( ) ) ) {
+      if ( this->IsAt( open ) ) {
+        ++depth;
+      } else if ( this->IsAt( close ) ) {
+        --depth;
+      }
+      ++this->_position;
+    }
+    return depth == 0;
+  }  // TokenScanner::SkipBalanced
+
+  StringRef TokenScanner::Qualify( const StringRef name )
+  {
+    std::vector< StringRef > names( this->_namespaces );
+    names.emplace_back( name );
+    return this->Join( names, names.size( ) );
+  }  // TokenScanner::Qualify
+
+  StringRef TokenScanner::Join( const std::vector< StringRef > &names, const std::size_t count )
+  {
+    this->_scratch.clear( );
+    for ( std::size_t i = 0; i < count; ++i ) {
+      this->_scratch.append( ( i == 0 ) ? "" : "::" );
+      this->_scratch.append( names[i].data( ), names[i].size( ) );
+    }
+    return this->_strings.Intern( StringRef( this->_scratch ) );
+  }  // TokenScanner::Join
+}  // namespace RomanoViolet
@@ -0,0 +1,124 @@
+#ifndef _TOKENSCANNER_HPP_
+#define _TOKENSCANNER_HPP_
+
+#include "Cursor.hpp"
+#include "StringPool.hpp"
+#include <clang-c/Index.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  class StateMachine;
+
+  /**
+   * @brief Extracts the IO of components from the tokens of a header alone, without the semantic
+   * parse of everything it includes.
+   * @details The main file of the translation unit is tokenized (see clang_tokenize), and scanned
+   * for the layout components follow, e.g., TestVectors/Component.hpp:
+   *   namespace N { ... class C : public Base { fields, enums, constructors, methods }; ... }
+   * For what is recognised, the scan synthesizes the cursors a traversal would feed to
+   * StateMachine, so that the results are the ones of the regular extraction, by construction.
+   * Since nothing but the main file is seen, names cannot be looked up. The scan therefore gives
+   * up, and the header is to be extracted as usual, as soon as the tokens leave the layout, e.g.,
+   * on templates, structs, typedefs, forward declarations, default member initializers,
+   * preprocessor conditionals besides an include guard, qualified names which are not absolute,
+   * or fields whose direction or type would depend on lookup. Assumed, but not checked:
+   *   - qualifiers of absolute names, e.g., ::RomanoViolet::, name namespaces, not classes or
+   *     namespace aliases,
+   *   - the base of a class is spelled by libclang as written, e.g., TypeHighAssuranceComponent,
+   *   - macros defined by included headers are not used.
+   * The translation unit may be a parse of the header alone, see CXTranslationUnit_SingleFileParse.
+   */
+  class TokenScanner
+  {
+  public:
+    explicit TokenScanner( CXTranslationUnit tu );
+    TokenScanner( const TokenScanner & ) = delete;
+    TokenScanner &operator=( const TokenScanner & ) = delete;
+
+    /**
+     * @brief Scans the main file.
+     * @param allClasses: Scan every class. Otherwise the scan ends with the first class defined,
+     * which is the only one extracted, and the remainder of the header need not follow the layout.
+     * @return false if the header does not follow the layout, see GetLineOfFailure.
+     */
+    bool Scan( const bool allClasses );
+
+    // The line of the main file at which the scan gave up. 0 if it did not.
+    unsigned GetLineOfFailure( ) const;
+    std::size_t GetNumberOfTokens( ) const;
+
+    /**
+     * @brief The first class defined in the header, and the namespaces enclosing it, e.g.,
+     * "NN::RomanoViolet", as found by the first pass of the two-pass extraction. Empty if there is
+     * none.
+     */
+    StringRef GetFirstClass( ) const;
+    StringRef GetFirstClassNamespaces( ) const;
+
+    /**
+     * @brief Feeds the cursors of a successful scan to stateMachine in the order, and with the
+     * pruning, of the traversal of the regular extraction.
+     * @param namespaceToInspect: Namespaces not enclosing it are skipped. Empty if not known.
+     */
+    void Feed( StateMachine &stateMachine,
+               const std::string &namespaceToInspect,
+               const bool allClasses ) const;
+
+  private:
+    struct Token {
+      CXTokenKind _kind;
+      StringRef _spelling;
+      unsigned _line;
+    };
+
+    // A namespace, the end of one, or a class and the cursors of its subtree.
+    struct Declaration {
+      enum class Kind : short { NAMESPACE, NAMESPACE_END, CLASS };
+      Kind _kind;
+      CursorEvent _event;
+      // namespaces only: e.g., "NN::RomanoViolet".
+      StringRef _qualifiedName;
+      // namespaces only: the index of the matching NAMESPACE_END.
+      std::size_t _end;
+      // classes only: base specifier, fields and the references in their types, in order.
+      std::vector< CursorEvent > _members;
+    };
+
+    StringPool _strings;
+    std::vector< Token > _tokens;
+    std::size_t _position;
+    unsigned _lineOfFailure;
+    std::vector< Declaration > _declarations;
+    // the enclosing namespaces while scanning, outermost first.
+    std::vector< StringRef > _namespaces;
+    std::uint32_t _numberOfClasses;
+    std::string _scratch;
+
+    // The token at _position + offset; a null token past the end.
+    const Token &Peek( const std::size_t offset = 0 ) const;
+    bool IsAt( const char *spelling, const std::size_t offset = 0 ) const;
+    bool IsIdentifierAt( const std::size_t offset = 0 ) const;
+    // Consumes the token if it is spelled spelling.
+    bool Accept( const char *spelling );
+    bool Fail( );
+
+    bool ScanDirectives( );
+    bool ScanNamespaceScope( const bool allClasses, bool &isDone );
+    bool ScanClass( );
+    bool ScanMember( Declaration &scope, CX_CXXAccessSpecifier &access );
+    bool ScanEnum( );
+    // isSpellingKnown: whether libclang spells the type as spelling, lookup notwithstanding.
+    bool ScanType( std::vector< CursorEvent > &events, StringRef &spelling, bool &isSpellingKnown );
+    bool ScanParameters( std::vector< CursorEvent > &events );
+    bool ScanFunctionTail( const bool isConstructor );
+    // Skips the tokens from open up to, and including, the matching close.
+    bool SkipBalanced( const char *open, const char *close );
+    // e.g., "NN::RomanoViolet::Component" for name "Component" with the namespaces open now.
+    StringRef Qualify( const StringRef name );
+    StringRef Join( const std::vector< StringRef > &names, const std::size_t count );
+  };  // class TokenScanner
+}  // namespace RomanoViolet
+#endif  // !_TOKENSCANNER_HPP_
@@ -0,0 +1,192 @@
+#include "WatchMode.hpp"
+#include <climits>
+#include <csignal>
+#include <cstdlib>
+#include <iostream>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+namespace RomanoViolet
+{
+  namespace
+  {
+    volatile std::sig_atomic_t isStopRequested = 0;
+
+    void requestStop( int signal )
+    {
+      ( void )signal;
+      isStopRequested = 1;
+    }
+
+    // Changes arriving within this interval of each other are handled together, e.g., all files
+    // touched by a checkout.
+    constexpr int settleMilliseconds = 50;
+    // Upper bound on the time it takes to notice a stop request.
+    constexpr int idleMilliseconds = 500;
+
+    std::string canonicalPath( const std::string &path )
+    {
+      char resolved[PATH_MAX];
+      return ( realpath( path.c_str( ), resolved ) == nullptr ) ? path : std::string( resolved );
+    }
+
+    void collectInclusion( CXFile includedFile,
+                           CXSourceLocation *inclusionStack,
+                           unsigned includeLength,
+                           CXClientData clientData )
+    {
+      ( void )inclusionStack;
+      ( void )includeLength;
+      auto *dependencies = static_cast< std::set< std::string > * >( clientData );
+      CXString fileName = clang_getFileName( includedFile );
+      dependencies->insert( canonicalPath( clang_getCString( fileName ) ) );
+      clang_disposeString( fileName );
+    }
+  }  // namespace
+
+  WatchMode::WatchMode( const std::vector< std::string > &headers,
+                        const TranslationUnitParser &parse,
+                        const TranslationUnitExtractor &extract )
+      : _parse( parse )
+      , _extract( extract )
+      , _index( clang_createIndex( /*excludeDeclarationsFromPCH=*/true,
+                                   /*displayDiagnostics=*/true ) )
+      , _units( headers.size( ) )
+      , _inotify( -1 )
+      , _directories( )
+  {
+    for ( std::size_t i = 0; i < headers.size( ); ++i ) {
+      this->_units[i]._header = headers[i];
+    }
+  }
+
+  WatchMode::~WatchMode( )
+  {
+    for ( Unit &unit : this->_units ) {
+      if ( unit._tu != nullptr ) {
+        clang_disposeTranslationUnit( unit._tu );
+      }
+    }
+    clang_disposeIndex( this->_index );
+    if ( this->_inotify >= 0 ) {
+      close( this->_inotify );
+    }
+  }
+
+  bool WatchMode::Update( Unit &unit )
+  {
+    if ( unit._tu != nullptr ) {
+      // the TU remains valid only if reparsing succeeded.
+      if ( clang_reparseTranslationUnit(
+               unit._tu, 0, nullptr, clang_defaultReparseOptions( unit._tu ) )
+           != 0 ) {
+        std::cerr << "Unable to reparse translation unit: " << unit._header << "\n";
+        clang_disposeTranslationUnit( unit._tu );
+        unit._tu = nullptr;
+      }
+    }
+    if ( unit._tu == nullptr ) {
+      unit._tu = this->_parse( this->_index, unit._header );
+    }
+
+    // on failure, the previous dependencies are kept so that a fix to any of them is noticed.
+    unit._dependencies.insert( canonicalPath( unit._header ) );
+    if ( unit._tu == nullptr ) {
+      return false;
+    }
+    unit._dependencies.clear( );
+    unit._dependencies.insert( canonicalPath( unit._header ) );
+    clang_getInclusions( unit._tu, collectInclusion, &unit._dependencies );
+    return true;
+  }  // WatchMode::Update
+
+  void WatchMode::Summarize( const Unit &unit, std::ostream &out )
+  {
+    if ( unit._tu != nullptr ) {
+      this->_extract( unit._tu, unit._header, out );
+    }
+    // consumers such as editors wait for the summary.
+    out.flush( );
+  }  // WatchMode::Summarize
+
+  void WatchMode::Watch( const Unit &unit )
+  {
+    // Directories are watched instead of files: replacing a file by renaming another one onto it
+    // would silently end a watch on the file itself.
+    const uint32_t mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_DELETE;
+    for ( const std::string &dependency : unit._dependencies ) {
+      const std::string directory = dependency.substr( 0, dependency.rfind( '/' ) );
+      const int descriptor = inotify_add_watch( this->_inotify, directory.c_str( ), mask );
+      if ( descriptor >= 0 ) {
+        // adding an already watched directory again yields the same descriptor.
+        this->_directories[descriptor] = directory;
+      }
+    }
+  }  // WatchMode::Watch
+
+  void WatchMode::CollectChanges( std::set< std::string > &changed )
+  {
+    pollfd descriptor;
+    descriptor.fd = this->_inotify;
+    descriptor.events = POLLIN;
+
+    int timeout = idleMilliseconds;
+    while ( !isStopRequested && ( poll( &descriptor, 1, timeout ) > 0 ) ) {
+      alignas( inotify_event ) char buffer[4096];
+      const ssize_t length = read( this->_inotify, buffer, sizeof( buffer ) );
+      for ( ssize_t offset = 0; offset < length; ) {
+        const inotify_event *event = reinterpret_cast< const inotify_event * >( buffer + offset );
+        const auto directory = this->_directories.find( event->wd );
+        if ( ( event->len > 0 ) && ( directory != this->_directories.end( ) ) ) {
+          changed.insert( directory->second + "/" + event->name );
+        }
+        offset += sizeof( inotify_event ) + event->len;
+      }
+      timeout = settleMilliseconds;
+    }
+  }  // WatchMode::CollectChanges
+
+  bool WatchMode::Run( std::ostream &out )
+  {
+    this->_inotify = inotify_init1( IN_CLOEXEC );
+    if ( this->_inotify < 0 ) {
+      std::cerr << "Unable to initialize inotify.\n";
+      return false;
+    }
+
+    isStopRequested = 0;
+    std::signal( SIGINT, requestStop );
+    std::signal( SIGTERM, requestStop );
+
+    for ( Unit &unit : this->_units ) {
+      this->Update( unit );
+      this->Summarize( unit, out );
+      this->Watch( unit );
+    }
+
+    while ( !isStopRequested ) {
+      std::set< std::string > changed;
+      this->CollectChanges( changed );
+
+      // only the translation units which depend on a changed file are reparsed.
+      for ( Unit &unit : this->_units ) {
+        bool isAffected = false;
+        for ( const std::string &path : changed ) {
+          if ( unit._dependencies.count( path ) != 0 ) {
+            isAffected = true;
+            break;
+          }
+        }
+        if ( isAffected ) {
+          this->Update( unit );
+          this->Summarize( unit, out );
+          this->Watch( unit );
+        }
+      }
+    }
+
+    std::signal( SIGINT, SIG_DFL );
+    std::signal( SIGTERM, SIG_DFL );
+    return true;
+  }  // WatchMode::Run
+}  // namespace RomanoViolet
@@ -0,0 +1,74 @@
+#ifndef _WATCHMODE_HPP_
+#define _WATCHMODE_HPP_
+
+#include <clang-c/Index.h>
+#include <functional>
+#include <map>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+namespace RomanoViolet
+{
+  /**
+   * @brief Parses header into a translation unit which is kept resident, i.e., which supports
+   * clang_reparseTranslationUnit. Returns nullptr if the header could not be parsed.
+   */
+  using TranslationUnitParser
+      = std::function< CXTranslationUnit( CXIndex index, const std::string &header ) >;
+
+  /**
+   * @brief Runs the state machine over tu, the (re)parse of header, and writes the summary to out.
+   */
+  using TranslationUnitExtractor = std::function< void(
+      CXTranslationUnit tu, const std::string &header, std::ostream &out ) >;
+
+  /**
+   * @brief Long-lived mode which keeps the translation units of all headers resident, and only
+   * reparses the ones affected by a change.
+   * @details All headers are parsed and summarized once. Afterwards, the directories of every
+   * header and of every file it includes are watched with inotify. When a file is written or
+   * replaced (editors commonly write a temporary file and rename it), each translation unit that
+   * depends on the file is brought up to date with clang_reparseTranslationUnit, which reuses the
+   * precompiled preamble of the translation unit where possible, and summarized again. Each
+   * summary is flushed as soon as it is written. Runs until SIGINT or SIGTERM is received.
+   */
+  class WatchMode
+  {
+  public:
+    WatchMode( const std::vector< std::string > &headers,
+               const TranslationUnitParser &parse,
+               const TranslationUnitExtractor &extract );
+    ~WatchMode( );
+    WatchMode( const WatchMode & ) = delete;
+    WatchMode &operator=( const WatchMode & ) = delete;
+
+    /**
+     * @return false if inotify is not available.
+     */
+    bool Run( std::ostream &out );
+
+  private:
+    struct Unit {
+      std::string _header;
+      CXTranslationUnit _tu = nullptr;
+      // Canonical paths of the header and all files it includes.
+      std::set< std::string > _dependencies;
+    };
+
+    const TranslationUnitParser _parse;
+    const TranslationUnitExtractor _extract;
+    CXIndex _index;
+    std::vector< Unit > _units;
+
+    int _inotify;
+    // watch descriptor -> watched directory
+    std::map< int, std::string > _directories;
+
+    bool Update( Unit &unit );
+    void Summarize( const Unit &unit, std::ostream &out );
+    void Watch( const Unit &unit );
+    void CollectChanges( std::set< std::string > &changed );
+  };  // class WatchMode
+}  // namespace RomanoViolet
+#endif  // !_WATCHMODE_HPP_
@@ -20,4 +20,7 @@
 static_assert( "You need minimum C++11 standard to use this library" );
 #endif
 
+// Storage policies other than floats, for any of the standards above.
+#include "SafeTypesFixedPoint.hpp"
+
 #endif  // !SAFETYPES_HPP_
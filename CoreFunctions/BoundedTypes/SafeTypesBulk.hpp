@@ -0,0 +1,66 @@
+#ifndef SAFETYPES_BULK_HPP_
+#define SAFETYPES_BULK_HPP_
+
+#include "SafeTypes.hpp"
+#include <cstddef>
+namespace RomanoViolet
+{
+  // The bounds of a SafeType instantiation, without an instance, e.g.,
+  // SafeTypeBounds< VelocityType >::lowerBound( ). Only for SafeTypes storing a float: a
+  // fixed-point SafeType rounds values to its scale, which clamping floats does not.
+  template < typename SafeTypeT >
+  struct SafeTypeBounds {
+    static_assert( sizeof( SafeTypeT ) == 0,
+                   "SafeTypeBounds and clampToBounds need a SafeType with FloatStorage, the "
+                   "default storage policy. Construct a fixed-point SafeType per value instead." );
+    static constexpr float lowerBound( )
+    {
+      return 0.0F;
+    }
+    static constexpr float upperBound( )
+    {
+      return 0.0F;
+    }
+  };
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  struct SafeTypeBounds< SafeType< NumeratorForMinBound,
+                                   DenominatorForMinBound,
+                                   NumeratorForMaxBound,
+                                   DenominatorForMaxBound,
+                                   FloatStorage > > {
+    // computed as the constructors of SafeType compute them, such that clamping in bulk gives the
+    // same floats as constructing one SafeType per value.
+    static constexpr float lowerBound( )
+    {
+      return NumeratorForMinBound / ( DenominatorForMinBound * 1.0F );
+    }
+    static constexpr float upperBound( )
+    {
+      return NumeratorForMaxBound / ( DenominatorForMaxBound * 1.0F );
+    }
+  };
+
+  /**
+   * @brief Clamps count values into the bounds of SafeTypeT, four at a time where SSE is
+   * available.
+   * @details clamped[i] and errorCodes[i] are what SafeTypeT( values[i] ) would hold as value and
+   * error code, NaN included: a NaN is kept, without an error.
+   * @param clamped: may be values itself.
+   * @param errorCodes: may be nullptr, if the error code per value is of no interest.
+   * @return The error codes of all values or-ed together, i.e., whether any value underflowed
+   * (SafeTypeErrorCode::UNDERFLOW) or overflowed (SafeTypeErrorCode::OVERFLOW).
+   */
+  template < typename SafeTypeT >
+  unsigned clampToBounds( const float *values,
+                          float *clamped,
+                          std::size_t count,
+                          SafeTypeErrorCode *errorCodes = nullptr );
+}  // namespace RomanoViolet
+
+#include "SafeTypesBulk.inl"
+
+#endif  // !SAFETYPES_BULK_HPP_
@@ -0,0 +1,73 @@
+#ifndef SAFETYPES_BULK_INL_
+#define SAFETYPES_BULK_INL_
+
+#include "SafeTypesBulk.hpp"
+#if defined( __SSE__ ) || defined( _M_X64 )
+#include <xmmintrin.h>
+#define SAFETYPES_BULK_WITH_SSE_
+#endif
+
+namespace RomanoViolet
+{
+  // The error code of a value is built from the results of both comparisons, without branching.
+  static_assert( static_cast< unsigned >( SafeTypeErrorCode::UNDERFLOW ) == 1U
+                     && static_cast< unsigned >( SafeTypeErrorCode::OVERFLOW ) == 2U,
+                 "clampToBounds expects UNDERFLOW and OVERFLOW to be bits 0 and 1." );
+
+  template < typename SafeTypeT >
+  unsigned clampToBounds( const float *values,
+                          float *clamped,
+                          std::size_t count,
+                          SafeTypeErrorCode *errorCodes )
+  {
+    constexpr float lowerBound = SafeTypeBounds< SafeTypeT >::lowerBound( );
+    constexpr float upperBound = SafeTypeBounds< SafeTypeT >::upperBound( );
+
+    // one bit per value which underflowed, or overflowed, or-ed over all values.
+    unsigned underflows = 0U;
+    unsigned overflows = 0U;
+    std::size_t i = 0;
+
+#if defined( SAFETYPES_BULK_WITH_SSE_ )
+    const __m128 lower = _mm_set1_ps( lowerBound );
+    const __m128 upper = _mm_set1_ps( upperBound );
+    for ( ; i + 4 <= count; i += 4 ) {
+      const __m128 value = _mm_loadu_ps( values + i );
+      // ordered comparisons, as in the constructor: a NaN is neither below nor above.
+      const unsigned isBelow
+          = static_cast< unsigned >( _mm_movemask_ps( _mm_cmplt_ps( value, lower ) ) );
+      const unsigned isAbove
+          = static_cast< unsigned >( _mm_movemask_ps( _mm_cmpgt_ps( value, upper ) ) );
+      // min and max return their second operand if either operand is NaN, which keeps NaN values.
+      _mm_storeu_ps( clamped + i, _mm_min_ps( upper, _mm_max_ps( lower, value ) ) );
+
+      if ( errorCodes != nullptr ) {
+        for ( unsigned lane = 0; lane < 4; ++lane ) {
+          errorCodes[i + lane] = static_cast< SafeTypeErrorCode >(
+              ( ( isBelow >> lane ) & 1U ) | ( ( ( isAbove >> lane ) & 1U ) << 1 ) );
+        }
+      }
+      underflows |= isBelow;
+      overflows |= isAbove;
+    }
+#endif
+
+    // whatever is left over, or everything, if SSE is not available.
+    for ( ; i < count; ++i ) {
+      const float value = values[i];
+      const unsigned isBelow = ( value < lowerBound ) ? 1U : 0U;
+      const unsigned isAbove = ( value > upperBound ) ? 1U : 0U;
+      clamped[i] = ( isBelow != 0U ) ? lowerBound : ( ( isAbove != 0U ) ? upperBound : value );
+      if ( errorCodes != nullptr ) {
+        errorCodes[i] = static_cast< SafeTypeErrorCode >( isBelow | ( isAbove << 1 ) );
+      }
+      underflows |= isBelow;
+      overflows |= isAbove;
+    }
+
+    return ( ( underflows != 0U ) ? static_cast< unsigned >( SafeTypeErrorCode::UNDERFLOW ) : 0U )
+           | ( ( overflows != 0U ) ? static_cast< unsigned >( SafeTypeErrorCode::OVERFLOW ) : 0U );
+  }  // clampToBounds
+}  // namespace RomanoViolet
+
+#endif  //. #ifndef SAFETYPES_BULK_INL_
@@ -0,0 +1,61 @@
+#ifndef SAFETYPES_EXPRESSION_HPP_
+#define SAFETYPES_EXPRESSION_HPP_
+
+namespace RomanoViolet
+{
+  /**
+   * @brief Sums and differences of SafeType values, e.g., a + b - c + d, checked against the bounds
+   * once they are assigned to a SafeType.
+   * @details Reference semantics: the result is SafeTypeT( x ), x being the float value of the
+   * expression as written, i.e., C++ precedence and associativity, every operation on floats:
+   * ( ( a.getValue( ) + b.getValue( ) ) - c.getValue( ) ) + d.getValue( ) for the chain above. The
+   * bounds are checked, and the error code set, once, by the assignment, instead of after every
+   * operation: a chain leaving the bounds and coming back within is not clamped on the way.
+   *
+   * An expression holds the value of the operations so far instead of its operands. Every
+   * operation is one addition or subtraction, with or without inlining, and an expression does
+   * not refer to its operands once built. The operands are of one SafeType. For a fixed-point
+   * SafeType, see SafeTypesFixedPoint.hpp, the operations are on the scaled integers as stored,
+   * in a long long, instead of floats, and the result is clamped as its operator+ clamps.
+   */
+  template < typename SafeTypeT >
+  struct SafeTypeExpressionValue {
+    // float, for the SafeTypes storing floats. Specialized by the other storage policies.
+    using type = float;
+  };
+
+  template < typename SafeTypeT >
+  struct SafeTypeExpression {
+    // The SafeType the expression is assigned to. Also keeps the SafeType operand of the
+    // operators below out of template argument deduction, such that a float converts to it.
+    using ResultType = SafeTypeT;
+
+    // The value of the expression, neither checked nor clamped.
+    typename SafeTypeExpressionValue< SafeTypeT >::type _value;
+
+    SafeTypeExpression operator+( const SafeTypeT &other ) const;
+    SafeTypeExpression operator-( const SafeTypeT &other ) const;
+    SafeTypeExpression operator+( const SafeTypeExpression &other ) const;
+    SafeTypeExpression operator-( const SafeTypeExpression &other ) const;
+
+    // An expression of operand alone, for an operand on the left of an expression.
+    static SafeTypeExpression of( const SafeTypeT &operand );
+  };
+
+  // SafeTypeT + SafeTypeT, and SafeTypeT - SafeTypeT, are members of SafeType, an expression on
+  // the left a member of SafeTypeExpression. A SafeType on the left of an expression remains.
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  operator+( const typename SafeTypeExpression< SafeTypeT >::ResultType &left,
+             const SafeTypeExpression< SafeTypeT > &right );
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  operator-( const typename SafeTypeExpression< SafeTypeT >::ResultType &left,
+             const SafeTypeExpression< SafeTypeT > &right );
+}  // namespace RomanoViolet
+
+#include "SafeTypesExpression.inl"
+
+#endif  // !SAFETYPES_EXPRESSION_HPP_
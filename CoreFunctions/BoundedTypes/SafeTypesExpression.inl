@@ -0,0 +1,60 @@
+#ifndef SAFETYPES_EXPRESSION_INL_
+#define SAFETYPES_EXPRESSION_INL_
+
+#include "SafeTypesExpression.hpp"
+namespace RomanoViolet
+{
+  // SafeTypeT is a friend of SafeTypeExpression< SafeTypeT >: its value is read directly.
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  SafeTypeExpression< SafeTypeT >::operator+( const SafeTypeT &other ) const
+  {
+    return { this->_value + other._value };
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  SafeTypeExpression< SafeTypeT >::operator-( const SafeTypeT &other ) const
+  {
+    return { this->_value - other._value };
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  SafeTypeExpression< SafeTypeT >::operator+( const SafeTypeExpression &other ) const
+  {
+    return { this->_value + other._value };
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  SafeTypeExpression< SafeTypeT >::operator-( const SafeTypeExpression &other ) const
+  {
+    return { this->_value - other._value };
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT > SafeTypeExpression< SafeTypeT >::of( const SafeTypeT &operand )
+  {
+    return { operand._value };
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  operator+( const typename SafeTypeExpression< SafeTypeT >::ResultType &left,
+             const SafeTypeExpression< SafeTypeT > &right )
+  {
+    return SafeTypeExpression< SafeTypeT >::of( left ) + right;
+  }
+
+  template < typename SafeTypeT >
+  SafeTypeExpression< SafeTypeT >
+  operator-( const typename SafeTypeExpression< SafeTypeT >::ResultType &left,
+             const SafeTypeExpression< SafeTypeT > &right )
+  {
+    return SafeTypeExpression< SafeTypeT >::of( left ) - right;
+  }
+}  // namespace RomanoViolet
+
+#endif  //. #ifndef SAFETYPES_EXPRESSION_INL_
@@ -0,0 +1,116 @@
+#ifndef SAFETYPES_FIXEDPOINT_HPP_
+#define SAFETYPES_FIXEDPOINT_HPP_
+
+// For intellisense. The file is included by SafeTypes.hpp, once the class template is declared.
+#include "SafeTypes.hpp"
+#include "SafeTypesExpression.hpp"
+#include "SafeTypesStorage.hpp"
+namespace RomanoViolet
+{
+  /**
+   * @brief A SafeType storing its value multiplied by Scale, rounded to the nearest integer, e.g.,
+   * SafeType< 1, 4, 1, 1, FixedPointStorage< 4 > > stores [0.25, 1] as [1, 4] in a std::uint8_t.
+   * @details The bounds are scaled, and rounded inwards. Values are clamped into the scaled bounds
+   * as the float implementations clamp them, except that a value on a bound is within the bounds,
+   * and a NaN, which no integer stores, is clamped to the lower bound with
+   * SafeTypeErrorCode::UNDERFLOW. Apart from the construction from a float and getValue( ),
+   * everything is integer arithmetic. The interface is the one of the float implementations: sums
+   * and differences are SafeTypeExpression, on the scaled integers, and clamped once assigned.
+   */
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  class SafeType< NumeratorForMinBound,
+                  DenominatorForMinBound,
+                  NumeratorForMaxBound,
+                  DenominatorForMaxBound,
+                  FixedPointStorage< Scale > >
+  {
+    static_assert( DenominatorForMinBound != 0, "Denominator for lower bound cannot be zero." );
+    static_assert( DenominatorForMaxBound != 0, "Denominator for upper bound cannot be zero." );
+
+    // The scaled bounds. A zero denominator, rejected above, gives a bound of zero instead of a
+    // division by zero.
+    static constexpr long long _min
+        = ( DenominatorForMinBound != 0 )
+              ? ceilOfFraction( static_cast< long long >( NumeratorForMinBound ) * Scale,
+                                DenominatorForMinBound )
+              : 0;
+    static constexpr long long _max
+        = ( DenominatorForMaxBound != 0 )
+              ? floorOfFraction( static_cast< long long >( NumeratorForMaxBound ) * Scale,
+                                 DenominatorForMaxBound )
+              : 0;
+
+    static_assert( _min < _max,
+                   "Provided lower bound is not less than the provided upper bound at this scale. "
+                   "Abort" );
+
+  public:
+    // The integer the value is stored in: the narrowest holding the scaled bounds.
+    using StorageType = typename NarrowestInteger< _min, _max >::type;
+
+    SafeType( float value );
+    float getMinValue( ) const;
+    float getValue( ) const;
+    // The value multiplied by Scale, as stored.
+    StorageType getScaledValue( ) const;
+    SafeTypeErrorCode getErrorCode( ) const;
+
+    // copy constructor
+    SafeType( const SafeType &other );
+
+    // assignment operator
+    SafeType &operator=( const SafeType &other );
+
+    // from a sum or difference of SafeType values, e.g., a + b - c: the scaled integer value of the
+    // expression, clamped once into the scaled bounds. The scaled values of the chain must fit
+    // into a long long, as they do for a sum or difference of two.
+    SafeType( const SafeTypeExpression< SafeType > &expression );
+    SafeType &operator=( const SafeTypeExpression< SafeType > &expression );
+
+    // addition operator: the sum, evaluated once it is assigned to a SafeType, see
+    // SafeTypesExpression.hpp. *this is left unchanged.
+    SafeTypeExpression< SafeType > operator+( const SafeType &other ) const;
+
+    // subtraction operator: the difference, evaluated as the sum.
+    SafeTypeExpression< SafeType > operator-( const SafeType &other ) const;
+
+    // Adds other, clamping the sum into the scaled bounds.
+    SafeType &operator+=( const SafeType &other );
+
+    // Subtracts other, clamping the difference as the sum.
+    SafeType &operator-=( const SafeType &other );
+
+  private:
+    // reads _value of its operands.
+    friend struct SafeTypeExpression< SafeType >;
+
+    StorageType _value;
+    SafeTypeErrorCode _errorCode;
+
+    // Clamps scaledValue, which may be beyond the bounds, e.g., a sum, without branching.
+    static SafeType fromScaledValue( long long scaledValue );
+    SafeType( StorageType scaledValue, SafeTypeErrorCode errorCode );
+  };
+
+  // Expressions of a fixed-point SafeType carry the scaled integers.
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  struct SafeTypeExpressionValue< SafeType< NumeratorForMinBound,
+                                            DenominatorForMinBound,
+                                            NumeratorForMaxBound,
+                                            DenominatorForMaxBound,
+                                            FixedPointStorage< Scale > > > {
+    using type = long long;
+  };
+}  // namespace RomanoViolet
+
+#include "SafeTypesFixedPoint.inl"
+
+#endif  // !SAFETYPES_FIXEDPOINT_HPP_
@@ -0,0 +1,302 @@
+#ifndef SAFETYPES_FIXEDPOINT_INL_
+#define SAFETYPES_FIXEDPOINT_INL_
+
+#include "SafeTypesFixedPoint.hpp"
+#include <cmath>
+
+namespace RomanoViolet
+{
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::SafeType( float value )
+  {
+    const float scaledValue = value * Scale;
+    // negated, such that a NaN underflows.
+    if ( !( scaledValue >= _min ) ) {
+      this->_value = static_cast< StorageType >( _min );
+      this->_errorCode = SafeTypeErrorCode::UNDERFLOW;
+    } else if ( scaledValue > _max ) {
+      this->_value = static_cast< StorageType >( _max );
+      this->_errorCode = SafeTypeErrorCode::OVERFLOW;
+    } else {
+      this->_value = static_cast< StorageType >( std::llround( scaledValue ) );
+      this->_errorCode = SafeTypeErrorCode::NO_ERROR;
+    }
+  }  // constructor
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::SafeType( StorageType scaledValue,
+                                                    SafeTypeErrorCode errorCode )
+      : _value( scaledValue ), _errorCode( errorCode )
+  {
+  }  // constructor
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  float SafeType< NumeratorForMinBound,
+                  DenominatorForMinBound,
+                  NumeratorForMaxBound,
+                  DenominatorForMaxBound,
+                  FixedPointStorage< Scale > >::getMinValue( ) const
+  {
+    return static_cast< float >( _min ) / Scale;
+  }  // getMinValue
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  float SafeType< NumeratorForMinBound,
+                  DenominatorForMinBound,
+                  NumeratorForMaxBound,
+                  DenominatorForMaxBound,
+                  FixedPointStorage< Scale > >::getValue( ) const
+  {
+    return static_cast< float >( this->_value ) / Scale;
+  }  // getValue
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  typename SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::StorageType
+  SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::getScaledValue( ) const
+  {
+    return this->_value;
+  }  // getScaledValue
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeTypeErrorCode SafeType< NumeratorForMinBound,
+                              DenominatorForMinBound,
+                              NumeratorForMaxBound,
+                              DenominatorForMaxBound,
+                              FixedPointStorage< Scale > >::getErrorCode( ) const
+  {
+    return this->_errorCode;
+  }  // getErrorCode
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::SafeType( const SafeType &other )
+  {
+    this->_value = other._value;
+    this->_errorCode = other._errorCode;
+  }  // copy constructor
+
+  // assignment operator
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > > &
+  SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::operator=( const SafeType &other )
+  {
+    this->_value = other._value;
+    this->_errorCode = other._errorCode;
+    return *this;
+  }  // operator=
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >
+  SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::fromScaledValue( long long scaledValue )
+  {
+    const bool isBelow = scaledValue < _min;
+    const bool isAbove = scaledValue > _max;
+    return SafeType(
+        static_cast< StorageType >( isBelow ? _min : ( isAbove ? _max : scaledValue ) ),
+        static_cast< SafeTypeErrorCode >( static_cast< std::uint8_t >( isBelow )
+                                          | ( static_cast< std::uint8_t >( isAbove ) << 1 ) ) );
+  }  // fromScaledValue
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::SafeType(
+      const SafeTypeExpression< SafeType > &expression )
+      : SafeType( fromScaledValue( expression._value ) )
+  {
+  }  // constructor
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > > &
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::operator=(
+      const SafeTypeExpression< SafeType > &expression )
+  {
+    *this = fromScaledValue( expression._value );
+    return *this;
+  }  // operator=
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  auto SafeType< NumeratorForMinBound,
+                 DenominatorForMinBound,
+                 NumeratorForMaxBound,
+                 DenominatorForMaxBound,
+                 FixedPointStorage< Scale > >::operator+( const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
+  {
+    // the scaled values fit into a long long, as does their sum or difference.
+    return { static_cast< long long >( this->_value ) + static_cast< long long >( other._value ) };
+  }  // operator+
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  auto SafeType< NumeratorForMinBound,
+                 DenominatorForMinBound,
+                 NumeratorForMaxBound,
+                 DenominatorForMaxBound,
+                 FixedPointStorage< Scale > >::operator-( const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
+  {
+    return { static_cast< long long >( this->_value ) - static_cast< long long >( other._value ) };
+  }  // operator-
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > > &
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::operator+=( const SafeType &other )
+  {
+    *this = *this + other;
+    return *this;
+  }  // operator+=
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > > &
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound,
+            FixedPointStorage< Scale > >::operator-=( const SafeType &other )
+  {
+    *this = *this - other;
+    return *this;
+  }  // operator-=
+
+  // Out-of-class definitions of the bounds, needed until C++17 wherever they are odr-used.
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  constexpr long long SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::_min;
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound,
+             int Scale >
+  constexpr long long SafeType< NumeratorForMinBound,
+          DenominatorForMinBound,
+          NumeratorForMaxBound,
+          DenominatorForMaxBound,
+          FixedPointStorage< Scale > >::_max;
+}  // namespace RomanoViolet
+
+#endif  //. #ifndef SAFETYPES_FIXEDPOINT_INL_
@@ -0,0 +1,93 @@
+#ifndef SAFETYPES_STORAGE_HPP_
+#define SAFETYPES_STORAGE_HPP_
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#if defined( __SSE__ ) || defined( _M_X64 )
+#include <xmmintrin.h>
+#endif
+namespace RomanoViolet
+{
+  // Storage policies, the last template parameter of SafeType.
+
+  // The value is a float, compared with the bounds as floats. The default.
+  struct FloatStorage {
+  };
+
+  // The value is stored multiplied by Scale, as the narrowest integer holding every value within
+  // the bounds, see SafeTypesFixedPoint.hpp. Arithmetic is integer arithmetic.
+  template < int Scale >
+  struct FixedPointStorage {
+    static_assert( Scale > 0, "The scale of a fixed-point SafeType must be positive." );
+  };
+
+  // Whole numbers only, e.g., counters.
+  using IntegerStorage = FixedPointStorage< 1 >;
+
+  // numerator / denominator, rounded towards negative infinity, or towards positive infinity.
+  constexpr long long floorOfFraction( long long numerator, long long denominator )
+  {
+    return ( denominator < 0 ) ? floorOfFraction( -numerator, -denominator )
+                               : ( numerator / denominator )
+                                     - ( ( ( numerator % denominator ) != 0 ) && ( numerator < 0 )
+                                             ? 1
+                                             : 0 );
+  }
+  constexpr long long ceilOfFraction( long long numerator, long long denominator )
+  {
+    return -floorOfFraction( -numerator, denominator );
+  }
+
+  // The narrowest of the fixed-width integers holding every value in [Min, Max].
+  template < long long Min, long long Max >
+  struct NarrowestInteger {
+  private:
+    template < typename Integer >
+    struct Holds {
+      using Limits = std::numeric_limits< Integer >;
+      static constexpr bool value
+          = ( Min >= static_cast< long long >( Limits::min( ) ) )
+            && ( ( Max < 0 )
+                 || ( static_cast< unsigned long long >( Max )
+                      <= static_cast< unsigned long long >( Limits::max( ) ) ) );
+    };
+
+  public:
+    using type = typename std::conditional<
+        Holds< std::uint8_t >::value,
+        std::uint8_t,
+        typename std::conditional<
+            Holds< std::int8_t >::value,
+            std::int8_t,
+            typename std::conditional<
+                Holds< std::uint16_t >::value,
+                std::uint16_t,
+                typename std::conditional<
+                    Holds< std::int16_t >::value,
+                    std::int16_t,
+                    typename std::conditional<
+                        Holds< std::uint32_t >::value,
+                        std::uint32_t,
+                        typename std::conditional< Holds< std::int32_t >::value,
+                                                   std::int32_t,
+                                                   std::int64_t >::type >::type >::type >::type >::
+            type >::type;
+  };
+
+  // value clamped into [lowerBound, upperBound], a NaN kept, as the constructors clamp it. With
+  // SSE, a min and a max: compilers turn the equivalent selects on a float back into jumps.
+  inline float clampBetween( float value, float lowerBound, float upperBound )
+  {
+#if defined( __SSE__ ) || defined( _M_X64 )
+    // min and max return their second operand if either operand is NaN.
+    const __m128 raised = _mm_max_ss( _mm_set_ss( lowerBound ), _mm_set_ss( value ) );
+    return _mm_cvtss_f32( _mm_min_ss( _mm_set_ss( upperBound ), raised ) );
+#else
+    const float raised = ( value < lowerBound ) ? lowerBound : value;
+    return ( raised > upperBound ) ? upperBound : raised;
+#endif
+  }
+}  // namespace RomanoViolet
+
+#endif  // !SAFETYPES_STORAGE_HPP_
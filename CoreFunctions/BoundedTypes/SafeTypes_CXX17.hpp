@@ -1,22 +1,36 @@
 #ifndef SAFETYPES_CXX17_HPP_
 #define SAFETYPES_CXX17_HPP_
 
+#include "SafeTypesExpression.hpp"
+#include "SafeTypesStorage.hpp"
 #include <cstdint>
 namespace RomanoViolet
 {
-  enum class SafeTypeErrorCode : short { NO_ERROR = 0U, UNDERFLOW = 1U, OVERFLOW = 2U };
+  enum class SafeTypeErrorCode : std::uint8_t { NO_ERROR = 0U, UNDERFLOW = 1U, OVERFLOW = 2U };
   // It would be convenient to have a custom type as a template parameter, but see
   // https://stackoverflow.com/q/15896579
   template < int NumeratorForMinBound = 1,
              int DenominatorForMinBound = 1,
              int NumeratorForMaxBound = 1,
-             int DenominatorForMaxBound = 1 >
-  class SafeType
+             int DenominatorForMaxBound = 1,
+             typename StoragePolicy = FloatStorage >
+  class SafeType;
+
+  // The value is stored as a float. See SafeTypesFixedPoint.hpp for the integer storage.
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  class SafeType< NumeratorForMinBound,
+                  DenominatorForMinBound,
+                  NumeratorForMaxBound,
+                  DenominatorForMaxBound,
+                  FloatStorage >
   {
   public:
     SafeType( float value );
-    float getMinValue( );
-    float getValue( );
+    float getMinValue( ) const;
+    float getValue( ) const;
     SafeTypeErrorCode getErrorCode( ) const;
 
     // copy constructor
@@ -25,21 +39,49 @@ namespace RomanoViolet
     // assignment operator
     SafeType &operator=( const SafeType &other );
 
-    // addition operator
-    SafeType operator+( const SafeType &other );
+    // from a sum or difference of SafeType values, e.g., a + b - c: the float value of the
+    // expression, clamped once into the bounds as the constructor from a float clamps.
+    SafeType( const SafeTypeExpression< SafeType > &expression );
+    SafeType &operator=( const SafeTypeExpression< SafeType > &expression );
 
-    // subtraction operator
-    SafeType operator-( const SafeType &other );
+    // addition operator: the sum, evaluated once it is assigned to a SafeType, see
+    // SafeTypesExpression.hpp. *this is left unchanged.
+    SafeTypeExpression< SafeType > operator+( const SafeType &other ) const;
+
+    // subtraction operator: the difference, evaluated as the sum.
+    SafeTypeExpression< SafeType > operator-( const SafeType &other ) const;
+
+    // Adds other, clamping the sum as the constructor clamps.
+    SafeType &operator+=( const SafeType &other );
+
+    // Subtracts other, clamping the difference as the constructor clamps.
+    SafeType &operator-=( const SafeType &other );
 
     // allows: float x = Object.
     // operator float( ) const;
 
   private:
-    float _min;
-    float _max;
+    // reads _value of its operands.
+    friend struct SafeTypeExpression< SafeType >;
+
+    // The bounds live in the type only: an instance holds its value and error code alone. A zero
+    // denominator, rejected by the constructor, gives a bound of zero instead of dividing by zero.
+    static constexpr float _min = ( DenominatorForMinBound != 0 )
+                                      ? NumeratorForMinBound / ( DenominatorForMinBound * 1.0F )
+                                      : 0.0F;
+    static constexpr float _max = ( DenominatorForMaxBound != 0 )
+                                      ? NumeratorForMaxBound / ( DenominatorForMaxBound * 1.0F )
+                                      : 0.0F;
     float _value;
     SafeTypeErrorCode _errorCode;
 
+    // Stores value, clamped into the bounds, and its error code, without branching, as the
+    // constructor from a float does. Unlike the if/else-if chains operator+ and operator- were
+    // before, which left _value and _errorCode untouched in either case:
+    //  - a sum or difference exactly on a bound is stored, with NO_ERROR,
+    //  - a NaN sum or difference is stored, with NO_ERROR.
+    void saturate( float value );
+
     struct NewFraction {
       int numerator = 1;
       int denominator = 1;
@@ -60,7 +102,7 @@ namespace RomanoViolet
   {
   public:
     SafeType( float value );
-    float getValue( );
+    float getValue( ) const;
     SafeTypeErrorCode getErrorCode( ) const;
 
     // copy constructor
@@ -69,18 +111,38 @@ namespace RomanoViolet
     // assignment operator
     SafeType &operator=( const SafeType &other );
 
-    // addition operator
-    SafeType operator+( const SafeType &other );
+    // from a sum or difference of SafeType values, e.g., a + b - c: the float value of the
+    // expression, clamped once into the bounds as the constructor from a float clamps.
+    SafeType( const SafeTypeExpression< SafeType > &expression );
+    SafeType &operator=( const SafeTypeExpression< SafeType > &expression );
+
+    // addition operator: the sum, evaluated once it is assigned to a SafeType, see
+    // SafeTypesExpression.hpp. *this is left unchanged.
+    SafeTypeExpression< SafeType > operator+( const SafeType &other ) const;
 
-    // subtraction operator
-    SafeType operator-( const SafeType &other );
+    // subtraction operator: the difference, evaluated as the sum.
+    SafeTypeExpression< SafeType > operator-( const SafeType &other ) const;
+
+    // Adds other, clamping the sum as the constructor clamps.
+    SafeType &operator+=( const SafeType &other );
+
+    // Subtracts other, clamping the difference as the constructor clamps.
+    SafeType &operator-=( const SafeType &other );
 
   private:
-    int _min;
-    int _max;
+    // reads _value of its operands.
+    friend struct SafeTypeExpression< SafeType >;
+
+    // The bounds live in the type only, as above.
+    static constexpr int _min = NumeratorForMinBound;
+    static constexpr int _max = NumeratorForMaxBound;
     float _value;
     SafeTypeErrorCode _errorCode;
 
+    // Stores value, clamped into the bounds, and its error code, without branching, as above: a
+    // sum or difference on a bound, or NaN, is stored with NO_ERROR.
+    void saturate( float value );
+
     // define temporary data structure to hold new numerators and denominators if these need to be
     // transformed.
     struct NewFraction {
@@ -21,8 +21,6 @@ namespace RomanoViolet
             DenominatorForMinBound,
             NumeratorForMaxBound,
             DenominatorForMaxBound >::SafeType( float value )
-      : _min( NumeratorForMinBound / ( DenominatorForMinBound * 1.0F ) )
-      , _max( NumeratorForMaxBound / ( DenominatorForMaxBound * 1.0F ) )
   {
     // assert that denominators are not zero.
     static_assert( DenominatorForMinBound != 0, "Denominator for lower bound cannot be zero." );
@@ -89,7 +87,7 @@ namespace RomanoViolet
   float SafeType< NumeratorForMinBound,
                   DenominatorForMinBound,
                   NumeratorForMaxBound,
-                  DenominatorForMaxBound >::getMinValue( )
+                  DenominatorForMaxBound >::getMinValue( ) const
   {
     return this->_min;
   }  // getMinValue
@@ -101,11 +99,23 @@ namespace RomanoViolet
   float SafeType< NumeratorForMinBound,
                   DenominatorForMinBound,
                   NumeratorForMaxBound,
-                  DenominatorForMaxBound >::getValue( )
+                  DenominatorForMaxBound >::getValue( ) const
   {
     return this->_value;
   }  // getValue
 
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  SafeTypeErrorCode SafeType< NumeratorForMinBound,
+                              DenominatorForMinBound,
+                              NumeratorForMaxBound,
+                              DenominatorForMaxBound >::getErrorCode( ) const
+  {
+    return this->_errorCode;
+  }  // getErrorCode
+
   template < int NumeratorForMinBound,
              int DenominatorForMinBound,
              int NumeratorForMaxBound,
@@ -115,8 +125,6 @@ namespace RomanoViolet
             NumeratorForMaxBound,
             DenominatorForMaxBound >::SafeType( const SafeType &other )
   {
-    this->_min = other._min;
-    this->_max = other._max;
     this->_value = other._value;
     this->_errorCode = other._errorCode;
   }
@@ -135,8 +143,6 @@ namespace RomanoViolet
             NumeratorForMaxBound,
             DenominatorForMaxBound >::operator=( const SafeType &other )
   {
-    this->_min = other._min;
-    this->_max = other._max;
     this->_value = other._value;
     this->_errorCode = other._errorCode;
     return *this;
@@ -149,26 +155,56 @@ namespace RomanoViolet
   SafeType< NumeratorForMinBound,
             DenominatorForMinBound,
             NumeratorForMaxBound,
-            DenominatorForMaxBound >
+            DenominatorForMaxBound >::SafeType( const SafeTypeExpression< SafeType > &expression )
+  {
+    // saturate( ) clamps as the constructor from a float, whose bound checks the operands already
+    // passed, without its branches.
+    this->saturate( expression._value );
+  }
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound > &
   SafeType< NumeratorForMinBound,
             DenominatorForMinBound,
             NumeratorForMaxBound,
-            DenominatorForMaxBound >::operator+( const SafeType &other )
+            DenominatorForMaxBound >::operator=( const SafeTypeExpression< SafeType > &expression )
   {
-    if ( ( this->_value + other._value < _max ) && ( this->_value + other._value > _min ) ) {
-      this->_value += other._value;
-      this->_errorCode = SafeTypeErrorCode::NO_ERROR;
-    } else if ( this->_value + other._value > _max ) {
-      this->_value = _max;
-      this->_errorCode = SafeTypeErrorCode::OVERFLOW;
-    } else if ( this->_value + other._value < _min ) {
-      this->_value = _min;
-      this->_errorCode = SafeTypeErrorCode::UNDERFLOW;
-    }
-
+    this->saturate( expression._value );
     return *this;
   }
 
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  auto SafeType< NumeratorForMinBound,
+                 DenominatorForMinBound,
+                 NumeratorForMaxBound,
+                 DenominatorForMaxBound >::operator+( const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
+  {
+    return { this->_value + other._value };
+  }  // operator+
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  auto SafeType< NumeratorForMinBound,
+                 DenominatorForMinBound,
+                 NumeratorForMaxBound,
+                 DenominatorForMaxBound >::operator-( const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
+  {
+    return { this->_value - other._value };
+  }  // operator-
+
   template < int NumeratorForMinBound,
              int DenominatorForMinBound,
              int NumeratorForMaxBound,
@@ -176,32 +212,55 @@ namespace RomanoViolet
   SafeType< NumeratorForMinBound,
             DenominatorForMinBound,
             NumeratorForMaxBound,
-            DenominatorForMaxBound >
+            DenominatorForMaxBound > &
   SafeType< NumeratorForMinBound,
             DenominatorForMinBound,
             NumeratorForMaxBound,
-            DenominatorForMaxBound >::operator-( const SafeType &other )
+            DenominatorForMaxBound >::operator+=( const SafeType &other )
   {
-    // The following does not work since the new temporary is constrained by the same bounds are
-    // *this, therefore, negation may floor the value before subtraction leading to incorrect
-    // results. return ( this->operator+( SafeType( -1.0 * other._value ) ) );
-    if ( ( this->_value - other._value > _min ) && ( this->_value - other._value < _max ) ) {
-      this->_value -= other._value;
-      this->_errorCode = SafeTypeErrorCode::NO_ERROR;
-    } else if ( this->_value - other._value > _max ) {
-      this->_value = _max;
-      this->_errorCode = SafeTypeErrorCode::OVERFLOW;
-    } else if ( this->_value - other._value < _min ) {
-      this->_value = _min;
-      this->_errorCode = SafeTypeErrorCode::UNDERFLOW;
-    }
+    this->saturate( this->_value + other._value );
+    return *this;
+  }  // operator+=
 
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound > &
+  SafeType< NumeratorForMinBound,
+            DenominatorForMinBound,
+            NumeratorForMaxBound,
+            DenominatorForMaxBound >::operator-=( const SafeType &other )
+  {
+    // Not *this += SafeType( -other ): the negated temporary would be clamped into the same bounds
+    // as *this before being added.
+    this->saturate( this->_value - other._value );
     return *this;
-  }
+  }  // operator-=
+
+  template < int NumeratorForMinBound,
+             int DenominatorForMinBound,
+             int NumeratorForMaxBound,
+             int DenominatorForMaxBound >
+  void SafeType< NumeratorForMinBound,
+                 DenominatorForMinBound,
+                 NumeratorForMaxBound,
+                 DenominatorForMaxBound >::saturate( float value )
+  {
+    // no if/else chain: the error code from both comparisons, the value from clampBetween. The
+    // comparisons are those of the constructor: a NaN is kept, without an error.
+    const bool isBelow = value < _min;
+    const bool isAbove = value > _max;
+    this->_value = clampBetween( value, _min, _max );
+    this->_errorCode = static_cast< SafeTypeErrorCode >(
+        static_cast< std::uint8_t >( isBelow ) | ( static_cast< std::uint8_t >( isAbove ) << 1 ) );
+  }  // saturate
 
   template < int NumeratorForMinBound, int NumeratorForMaxBound >
   SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::SafeType( float value )
-      : _min( NumeratorForMinBound ), _max( NumeratorForMaxBound )
   {
     // min and max bounds are correct.
     if ( value < _min ) {
@@ -217,16 +276,21 @@ namespace RomanoViolet
   }  // constructor
 
   template < int NumeratorForMinBound, int NumeratorForMaxBound >
-  float SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::getValue( )
+  float SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::getValue( ) const
   {
     return this->_value;
   }  // getValue
 
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  SafeTypeErrorCode
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::getErrorCode( ) const
+  {
+    return this->_errorCode;
+  }  // getErrorCode
+
   template < int NumeratorForMinBound, int NumeratorForMaxBound >
   SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::SafeType( const SafeType &other )
   {
-    this->_min = other._min;
-    this->_max = other._max;
     this->_value = other._value;
     this->_errorCode = other._errorCode;
   }
@@ -236,50 +300,76 @@ namespace RomanoViolet
   SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 > &
   SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator=( const SafeType &other )
   {
-    this->_min = other._min;
-    this->_max = other._max;
     this->_value = other._value;
     this->_errorCode = other._errorCode;
     return *this;
   }
 
   template < int NumeratorForMinBound, int NumeratorForMaxBound >
-  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >
-  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator+( const SafeType &other )
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::SafeType(
+      const SafeTypeExpression< SafeType > &expression )
   {
-    if ( ( this->_value + other._value < _max ) && ( this->_value + other._value > _min ) ) {
-      this->_value += other._value;
-      this->_errorCode = SafeTypeErrorCode::NO_ERROR;
-    } else if ( this->_value + other._value > _max ) {
-      this->_value = _max;
-      this->_errorCode = SafeTypeErrorCode::OVERFLOW;
-    } else if ( this->_value + other._value < _min ) {
-      this->_value = _min;
-      this->_errorCode = SafeTypeErrorCode::UNDERFLOW;
-    }
+    // saturate( ) clamps as the constructor from a float, whose bound checks the operands already
+    // passed, without its branches.
+    this->saturate( expression._value );
+  }
+
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 > &
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator=(
+      const SafeTypeExpression< SafeType > &expression )
+  {
+    this->saturate( expression._value );
     return *this;
   }
 
   template < int NumeratorForMinBound, int NumeratorForMaxBound >
-  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >
-  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator-( const SafeType &other )
+  auto SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator+(
+      const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
   {
-    // The following does not work since the new temporary is constrained by the same bounds are
-    // *this, therefore, negation may floor the value before subtraction leading to incorrect
-    // results. return ( this->operator+( SafeType( -1.0 * other._value ) ) );
-    if ( ( this->_value - other._value > _min ) && ( this->_value - other._value < _max ) ) {
-      this->_value -= other._value;
-      this->_errorCode = SafeTypeErrorCode::NO_ERROR;
-    } else if ( this->_value - other._value > _max ) {
-      this->_value = _max;
-      this->_errorCode = SafeTypeErrorCode::OVERFLOW;
-    } else if ( this->_value - other._value < _min ) {
-      this->_value = _min;
-      this->_errorCode = SafeTypeErrorCode::UNDERFLOW;
-    }
+    return { this->_value + other._value };
+  }  // operator+
+
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  auto SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator-(
+      const SafeType &other ) const
+      -> SafeTypeExpression< SafeType >
+  {
+    return { this->_value - other._value };
+  }  // operator-
 
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 > &
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator+=( const SafeType &other )
+  {
+    this->saturate( this->_value + other._value );
     return *this;
-  }
+  }  // operator+=
+
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 > &
+  SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::operator-=( const SafeType &other )
+  {
+    // Not *this += SafeType( -other ): the negated temporary would be clamped into the same bounds
+    // as *this before being added.
+    this->saturate( this->_value - other._value );
+    return *this;
+  }  // operator-=
+
+  template < int NumeratorForMinBound, int NumeratorForMaxBound >
+  void SafeType< NumeratorForMinBound, 1, NumeratorForMaxBound, 1 >::saturate( float value )
+  {
+    // no if/else chain: the error code from both comparisons, the value from clampBetween. The
+    // comparisons are those of the constructor: a NaN is kept, without an error.
+    const float lowerBound = static_cast< float >( _min );
+    const float upperBound = static_cast< float >( _max );
+    const bool isBelow = value < lowerBound;
+    const bool isAbove = value > upperBound;
+    this->_value = clampBetween( value, lowerBound, upperBound );
+    this->_errorCode = static_cast< SafeTypeErrorCode >(
+        static_cast< std::uint8_t >( isBelow ) | ( static_cast< std::uint8_t >( isAbove ) << 1 ) );
+  }  // saturate
 
 }  // namespace RomanoViolet
 